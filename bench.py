@@ -1,12 +1,13 @@
 #!/usr/bin/env python3
 import subprocess
 import json
+import re
 import sys
 import argparse
 import platform
 from pathlib import Path
 from collections import defaultdict
-from typing import Any
+from typing import Any, Optional
 
 HAS_MATPLOTLIB = False
 plt = None
@@ -40,10 +41,17 @@ def get_platform_name() -> str:
 
 PLOTS_DIR = PLOTS_BASE_DIR / get_platform_name()
 
-def run_benchmarks(graph_mode: bool = False) -> str:
+def run_benchmarks(graph_mode: bool = False, timeseries_ms: float = 0,
+                   size_dist: Optional[str] = None, touch: Optional[str] = None) -> str:
     cmd = [str(EXECUTABLE)]
     if graph_mode:
         cmd.append("--graph")
+    if timeseries_ms > 0:
+        cmd += ["--timeseries", str(timeseries_ms)]
+    if size_dist:
+        cmd += ["--size-dist", size_dist]
+    if touch:
+        cmd += ["--touch", touch]
     print(f"Running: {' '.join(cmd)}")
     result = subprocess.run(cmd, cwd=BUILD_DIR, capture_output=True, text=True)
     if result.returncode != 0:
@@ -89,6 +97,41 @@ def format_bytes(val: Any) -> str:
         return f"{val / (1 << 10):.2f} KB"
     return f"{val} B"
 
+def generate_system_section(data: dict) -> str:
+    system = data.get("system")
+    if not system:
+        return ""
+
+    md = "## Machine\n\n"
+    md += "| Property | Value |\n|----------|-------|\n"
+    md += f"| CPU | {system.get('cpu_model')} ({system.get('physical_cores')} cores / {system.get('logical_cpus')} threads) |\n"
+    md += f"| Governor / turbo | {system.get('governor')} / {system.get('turbo')} |\n"
+    md += f"| THP enabled / defrag | {system.get('thp_enabled')} / {system.get('thp_defrag')} |\n"
+    md += f"| Touch mode | {data.get('touch', 'none')} |\n"
+    md += f"| Kernel | {system.get('kernel')} |\n"
+    md += f"| vm.overcommit_memory | {system.get('overcommit_memory')} |\n"
+    md += f"| Compiler | {system.get('compiler')} ({system.get('build_type')}, `{system.get('c_flags')}`) |\n"
+    for name, rev in system.get("allocator_revisions", {}).items():
+        md += f"| {name} | {rev} |\n"
+    md += "\n"
+    return md
+
+def generate_extra_metrics_table(entries: list[dict]) -> str:
+    keys = []
+    for entry in entries:
+        for key in entry.get("extra", {}):
+            if key not in keys:
+                keys.append(key)
+    if not keys:
+        return ""
+
+    md = "| Allocator | " + " | ".join(keys) + " |\n"
+    md += "|-----------|" + "|".join(["-" * max(3, len(k)) for k in keys]) + "|\n"
+    for entry in entries:
+        extra = entry.get("extra", {})
+        md += f"| {entry['allocator']} | " + " | ".join(format_number(extra.get(k)) for k in keys) + " |\n"
+    return md + "\n"
+
 def generate_benchmark_tables(data: dict) -> str:
     md = "## Results\n\n"
     benchmarks = defaultdict(list)
@@ -102,8 +145,8 @@ def generate_benchmark_tables(data: dict) -> str:
         entries.sort(key=lambda x: x["metrics"]["total_ops_per_sec"], reverse=True)
 
         md += f"### {bench_name}\n\n"
-        md += "| Allocator | Total ops/s | Alloc ops/s | Free ops/s | Avg time (ns) | P50 (ns) | P99 (ns) | Peak RSS |\n"
-        md += "|-----------|-------------|-------------|------------|---------------|----------|----------|----------|\n"
+        md += "| Allocator | Total ops/s | Alloc ops/s | Free ops/s | Avg time (ns) | P50 (ns) | P99 (ns) | Peak RSS | Page faults |\n"
+        md += "|-----------|-------------|-------------|------------|---------------|----------|----------|----------|-------------|\n"
 
         winner = entries[0]["allocator"] if entries else None
         for entry in entries:
@@ -114,11 +157,12 @@ def generate_benchmark_tables(data: dict) -> str:
             p99 = format_number(m.get("p99_alloc_time_ns"), "ns") if m.get("p99_alloc_time_ns") else "N/A"
             peak_rss = format_bytes(m.get("peak_rss_kb", 0) * 1024)
 
-            md += f"| {alloc}{marker} | {format_number(m['total_ops_per_sec'])} | {format_number(m['alloc_ops_per_sec'])} | {format_number(m['free_ops_per_sec'])} | {format_number(m['avg_alloc_time_ns'], 'ns')} | {p50} | {p99} | {peak_rss} |\n"
+            md += f"| {alloc}{marker} | {format_number(m['total_ops_per_sec'])} | {format_number(m['alloc_ops_per_sec'])} | {format_number(m['free_ops_per_sec'])} | {format_number(m['avg_alloc_time_ns'], 'ns')} | {p50} | {p99} | {peak_rss} | {format_number(m.get('page_faults'))} |\n"
 
         if winner:
             overall_wins[winner] += 1
         md += "\n"
+        md += generate_extra_metrics_table(entries)
 
     if overall_wins:
         overall_winner = max(overall_wins.keys(), key=lambda x: overall_wins[x])
@@ -199,67 +243,254 @@ def generate_plots(graph_data: list[dict], plots_dir: Path) -> str:
 
     return md
 
-def generate_threaded_analysis(data: dict, plots_dir: Path) -> str:
-    md = "## Thread scaling\n\n"
-
-    threaded = defaultdict(dict)
+def generate_timeseries_plots(data: dict, plots_dir: Path) -> str:
+    series = defaultdict(dict)
     for entry in data.get("results", []):
-        bench = entry["benchmark"]
-        if bench.startswith("threaded_alloc_"):
-            thread_count = entry["metrics"].get("thread_count", 1)
-            alloc = entry["allocator"]
-            ops = entry["metrics"]["total_ops_per_sec"]
-            threaded[thread_count][alloc] = ops
+        ts = entry.get("throughput_series")
+        if ts and ts.get("values"):
+            series[entry["benchmark"]][entry["allocator"]] = ts
 
-    if not threaded:
-        return md + "*No threaded benchmark data available*\n\n"
+    if not series:
+        return ""
 
-    thread_counts = sorted(threaded.keys())
-    allocators = set()
-    for tc in thread_counts:
-        allocators.update(threaded[tc].keys())
-    allocators = sorted(allocators)
+    md = "## Throughput over time\n\n"
+    if not HAS_MATPLOTLIB:
+        return md + "*Matplotlib not available, skipping plots*\n\n"
 
-    md += "| Threads | " + " | ".join(allocators) + " | Best |\n"
-    md += "|---------|" + "|".join(["--------"] * (len(allocators) + 1)) + "|\n"
+    plots_dir.mkdir(parents=True, exist_ok=True)
+    for bench_name in sorted(series.keys()):
+        fig, ax = plt.subplots(figsize=(10, 6))
+        for alloc in sorted(series[bench_name].keys()):
+            ts = series[bench_name][alloc]
+            interval = ts["interval_ms"]
+            times = [i * interval for i in range(len(ts["values"]))]
+            ax.plot(times, ts["values"], label=alloc, linewidth=1.5)
+
+        ax.set_xlabel("Time (ms)")
+        ax.set_ylabel("Ops/sec")
+        ax.set_title(f"{bench_name} - Throughput over time")
+        ax.legend()
+        ax.grid(True, alpha=0.3)
 
-    for tc in thread_counts:
-        row = [str(tc)]
-        best_alloc = max(allocators, key=lambda a: threaded[tc].get(a, 0))
-        for alloc in allocators:
-            ops = threaded[tc].get(alloc, 0)
-            marker = " **" if alloc == best_alloc else ""
-            row.append(f"{format_number(ops)}{marker}")
-        row.append(best_alloc)
-        md += "| " + " | ".join(row) + " |\n"
+        plot_path = plots_dir / f"timeseries_{bench_name}.png"
+        plt.savefig(plot_path, dpi=150, bbox_inches='tight')
+        plt.close()
 
-    md += "\n"
+        rel_path = plot_path.relative_to(Path(__file__).parent).as_posix()
+        md += f"### {bench_name}\n\n![{bench_name} throughput]({rel_path})\n\n"
+
+    return md
+
+def generate_fragmentation_plots(data: dict, plots_dir: Path) -> str:
+    series = defaultdict(dict)
+    for entry in data.get("results", []):
+        fs = entry.get("fragmentation_series")
+        if fs and fs.get("values"):
+            series[entry["benchmark"]][entry["allocator"]] = fs
+
+    if not series:
+        return ""
 
-    if HAS_MATPLOTLIB and len(thread_counts) > 1:
-        plots_dir.mkdir(parents=True, exist_ok=True)
+    md = "## Fragmentation over time\n\n"
+    md += "RSS divided by live requested bytes; 0 marks samples with almost nothing live.\n\n"
+    if not HAS_MATPLOTLIB:
+        return md + "*Matplotlib not available, skipping plots*\n\n"
+
+    plots_dir.mkdir(parents=True, exist_ok=True)
+    for bench_name in sorted(series.keys()):
         fig, ax = plt.subplots(figsize=(10, 6))
-        for alloc in allocators:
-            ops_vals = [threaded[tc].get(alloc, 0) for tc in thread_counts]
-            ax.plot(thread_counts, ops_vals, marker='o', label=alloc, linewidth=2)
+        for alloc in sorted(series[bench_name].keys()):
+            fs = series[bench_name][alloc]
+            interval = fs["interval_ops"]
+            ops = [(i + 1) * interval for i in range(len(fs["values"]))]
+            ax.plot(ops, fs["values"], label=alloc, linewidth=1.5)
+
+        ax.set_xlabel("Operations")
+        ax.set_ylabel("RSS / live bytes")
+        ax.set_yscale("log")
+        ax.set_title(f"{bench_name} - Fragmentation over time")
+        ax.legend()
+        ax.grid(True, alpha=0.3)
+
+        plot_path = plots_dir / f"fragmentation_{bench_name}.png"
+        plt.savefig(plot_path, dpi=150, bbox_inches='tight')
+        plt.close()
+
+        rel_path = plot_path.relative_to(Path(__file__).parent).as_posix()
+        md += f"### {bench_name}\n\n![{bench_name} fragmentation]({rel_path})\n\n"
+
+    return md
 
-        ax.set_xlabel("Thread Count")
-        ax.set_ylabel("Total Ops/sec")
-        ax.set_title("Thread Scaling Performance")
+def generate_rss_plots(data: dict, plots_dir: Path) -> str:
+    series = defaultdict(dict)
+    for entry in data.get("results", []):
+        rs = entry.get("rss_series")
+        if rs and rs.get("values"):
+            series[entry["benchmark"]][entry["allocator"]] = rs
+
+    if not series:
+        return ""
+
+    md = "## RSS over time\n\n"
+    if not HAS_MATPLOTLIB:
+        return md + "*Matplotlib not available, skipping plots*\n\n"
+
+    plots_dir.mkdir(parents=True, exist_ok=True)
+    for bench_name in sorted(series.keys()):
+        fig, ax = plt.subplots(figsize=(10, 6))
+        for alloc in sorted(series[bench_name].keys()):
+            rs = series[bench_name][alloc]
+            interval = rs["interval_ms"]
+            times = [(i + 1) * interval for i in range(len(rs["values"]))]
+            ax.plot(times, [v / 1024 for v in rs["values"]], label=alloc, linewidth=1.5)
+
+        ax.set_xlabel("Time (ms)")
+        ax.set_ylabel("RSS (MB)")
+        ax.set_title(f"{bench_name} - RSS over time")
         ax.legend()
         ax.grid(True, alpha=0.3)
 
-        plot_path = plots_dir / "thread_scaling.png"
+        plot_path = plots_dir / f"rss_{bench_name}.png"
         plt.savefig(plot_path, dpi=150, bbox_inches='tight')
         plt.close()
 
         rel_path = plot_path.relative_to(Path(__file__).parent).as_posix()
-        md += f"![Thread Scaling]({rel_path})\n\n"
+        md += f"### {bench_name}\n\n![{bench_name} RSS]({rel_path})\n\n"
+
+    return md
+
+def fit_usl(points: list[tuple[int, float]]) -> Optional[dict]:
+    """Fits the Universal Scalability Law X(N) = lambda*N / (1 + sigma*(N-1) + kappa*N*(N-1)).
+
+    Uses the usual linearization N/C(N) - 1 = sigma*(N-1) + kappa*N*(N-1), with
+    C(N) = X(N)/X(1), solved by least squares through the origin.
+    """
+    base = dict(points).get(1)
+    if not base or len(points) < 3:
+        return None
+
+    saa = sab = sbb = say = sby = 0.0
+    for n, x in points:
+        if n == 1 or x <= 0:
+            continue
+        a = n - 1
+        b = n * (n - 1)
+        y = n / (x / base) - 1
+        saa += a * a
+        sab += a * b
+        sbb += b * b
+        say += a * y
+        sby += b * y
+
+    det = saa * sbb - sab * sab
+    if det == 0:
+        return None
+
+    sigma = max(0.0, (say * sbb - sby * sab) / det)
+    kappa = max(0.0, (saa * sby - sab * say) / det)
+    peak = ((1 - sigma) / kappa) ** 0.5 if kappa > 0 and sigma < 1 else None
+    return {"lambda": base, "sigma": sigma, "kappa": kappa, "peak_threads": peak}
+
+def usl_throughput(fit: dict, n: float) -> float:
+    return fit["lambda"] * n / (1 + fit["sigma"] * (n - 1) + fit["kappa"] * n * (n - 1))
+
+def collect_thread_sweeps(data: dict) -> dict:
+    sweeps = defaultdict(lambda: defaultdict(dict))
+    for entry in data.get("results", []):
+        match = re.match(r"^(.*)_(\d+)$", entry["benchmark"])
+        if not match:
+            continue
+        thread_count = entry["metrics"].get("thread_count", 1)
+        if thread_count != int(match.group(2)):
+            continue
+        sweeps[match.group(1)][thread_count][entry["allocator"]] = entry["metrics"]["total_ops_per_sec"]
+    return {prefix: counts for prefix, counts in sweeps.items() if len(counts) > 1}
+
+def generate_threaded_analysis(data: dict, plots_dir: Path) -> str:
+    md = "## Thread scaling\n\n"
+
+    sweeps = collect_thread_sweeps(data)
+    if not sweeps:
+        return md + "*No threaded benchmark data available*\n\n"
+
+    for prefix in sorted(sweeps.keys()):
+        threaded = sweeps[prefix]
+        thread_counts = sorted(threaded.keys())
+        allocators = set()
+        for tc in thread_counts:
+            allocators.update(threaded[tc].keys())
+        allocators = sorted(allocators)
+
+        md += f"### {prefix}\n\n"
+        md += "| Threads | " + " | ".join(allocators) + " | Best |\n"
+        md += "|---------|" + "|".join(["--------"] * (len(allocators) + 1)) + "|\n"
+
+        for tc in thread_counts:
+            row = [str(tc)]
+            best_alloc = max(allocators, key=lambda a: threaded[tc].get(a, 0))
+            for alloc in allocators:
+                ops = threaded[tc].get(alloc, 0)
+                marker = " **" if alloc == best_alloc else ""
+                row.append(f"{format_number(ops)}{marker}")
+            row.append(best_alloc)
+            md += "| " + " | ".join(row) + " |\n"
+
+        md += "\n"
+
+        fits = {}
+        for alloc in allocators:
+            points = [(tc, threaded[tc][alloc]) for tc in thread_counts if alloc in threaded[tc]]
+            fit = fit_usl(points)
+            if fit:
+                fits[alloc] = fit
+
+        if fits:
+            md += "Universal Scalability Law fit (sigma = contention, kappa = coherency):\n\n"
+            md += "| Allocator | lambda (ops/s) | sigma | kappa | Peak threads |\n"
+            md += "|-----------|----------------|-------|-------|--------------|\n"
+            for alloc, fit in fits.items():
+                peak = f"{fit['peak_threads']:.1f}" if fit["peak_threads"] else "unbounded"
+                md += f"| {alloc} | {format_number(fit['lambda'])} | {fit['sigma']:.4f} | {fit['kappa']:.6f} | {peak} |\n"
+            md += "\n"
+
+        if HAS_MATPLOTLIB:
+            plots_dir.mkdir(parents=True, exist_ok=True)
+            fig, ax = plt.subplots(figsize=(10, 6))
+            for alloc in allocators:
+                counts = [tc for tc in thread_counts if alloc in threaded[tc]]
+                ops_vals = [threaded[tc][alloc] for tc in counts]
+                line, = ax.plot(counts, ops_vals, marker='o', label=alloc, linewidth=2)
+                if alloc in fits:
+                    steps = 100
+                    xs = [1 + (thread_counts[-1] - 1) * i / steps for i in range(steps + 1)]
+                    ax.plot(xs, [usl_throughput(fits[alloc], x) for x in xs],
+                            linestyle='--', color=line.get_color(), linewidth=1)
+
+            ax.set_xlabel("Thread Count")
+            ax.set_ylabel("Total Ops/sec")
+            ax.set_title(f"{prefix} - Thread Scaling (dashed: USL fit)")
+            ax.legend()
+            ax.grid(True, alpha=0.3)
+
+            name = "thread_scaling" if prefix == "threaded_alloc" else f"thread_scaling_{prefix}"
+            plot_path = plots_dir / f"{name}.png"
+            plt.savefig(plot_path, dpi=150, bbox_inches='tight')
+            plt.close()
+
+            rel_path = plot_path.relative_to(Path(__file__).parent).as_posix()
+            md += f"![Thread Scaling]({rel_path})\n\n"
 
     return md
 
 def main():
     parser = argparse.ArgumentParser(description="Run allocator benchmarks and generate report")
     parser.add_argument("--skip-run", action="store_true", help="Skip running benchmarks")
+    parser.add_argument("--timeseries", type=float, default=0, metavar="MS",
+                        help="Record throughput per MS time slice and plot it")
+    parser.add_argument("--size-dist", metavar="SPEC",
+                        help="Allocation size distribution passed to allocbench (e.g. loguniform:8-64K)")
+    parser.add_argument("--touch", choices=["none", "first-line", "full"],
+                        help="Write to returned memory inside the timed region")
     args = parser.parse_args()
 
     platform_name = get_platform_name()
@@ -271,10 +502,11 @@ def main():
 
     if not args.skip_run:
         print("\n[1/4] Running standard benchmarks...")
-        run_benchmarks(graph_mode=False)
+        run_benchmarks(graph_mode=False, timeseries_ms=args.timeseries, size_dist=args.size_dist,
+                       touch=args.touch)
 
         print("\n[2/4] Running graph mode benchmarks...")
-        run_benchmarks(graph_mode=True)
+        run_benchmarks(graph_mode=True, size_dist=args.size_dist, touch=args.touch)
     else:
         print("\n[1/4] Skipping benchmark run (--skip-run)")
         print("[2/4] Skipping graph mode run (--skip-run)")
@@ -293,8 +525,13 @@ def main():
         allocators.add(entry["allocator"])
     md += ", ".join(sorted(allocators)) + "\n\n"
 
+    md += generate_system_section(benchmark_data)
+
     md += generate_benchmark_tables(benchmark_data)
     md += generate_threaded_analysis(benchmark_data, plots_dir)
+    md += generate_timeseries_plots(benchmark_data, plots_dir)
+    md += generate_fragmentation_plots(benchmark_data, plots_dir)
+    md += generate_rss_plots(benchmark_data, plots_dir)
     md += generate_plots(graph_data, plots_dir)
 
     with open(OUTPUT_FILE, "w") as f:
@@ -1,4 +1,9 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
 #include "allocator_api.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -26,6 +31,13 @@ static void system_aligned_free(void* ptr) {
 }
 #endif
 
+#ifdef __GLIBC__
+#include <malloc.h>
+static void system_purge(void) {
+    malloc_trim(0);
+}
+#endif
+
 void system_allocator_init(allocator_api_t* api) {
     memset(api, 0, sizeof(allocator_api_t));
     api->malloc = system_malloc;
@@ -34,6 +46,9 @@ void system_allocator_init(allocator_api_t* api) {
     api->free = system_free;
     api->aligned_alloc = system_aligned_alloc;
     api->aligned_free = system_aligned_free;
+#ifdef __GLIBC__
+    api->purge = system_purge;
+#endif
     api->name = "system";
 }
 
@@ -54,6 +69,9 @@ static int rp_init(void) {
 static void rp_cleanup(void) {
     rpmalloc_finalize();
 }
+static void rp_purge(void) {
+    rpmalloc_thread_collect();
+}
 
 void rpmalloc_allocator_init(allocator_api_t* api) {
     memset(api, 0, sizeof(allocator_api_t));
@@ -65,6 +83,7 @@ void rpmalloc_allocator_init(allocator_api_t* api) {
     api->aligned_free = rp_free;
     api->init = rp_init;
     api->cleanup = rp_cleanup;
+    api->purge = rp_purge;
     api->name = "rpmalloc";
 }
 #else
@@ -85,6 +104,11 @@ static void je_free_wrapper(void* ptr) { je_free(ptr); }
 static void* je_aligned_alloc_wrapper(size_t alignment, size_t size) {
     return je_aligned_alloc(alignment, size);
 }
+static void je_purge(void) {
+    char name[64];
+    snprintf(name, sizeof(name), "arena.%u.purge", (unsigned)MALLCTL_ARENAS_ALL);
+    je_mallctl(name, NULL, NULL, NULL, 0);
+}
 
 void jemalloc_allocator_init(allocator_api_t* api) {
     memset(api, 0, sizeof(allocator_api_t));
@@ -94,6 +118,7 @@ void jemalloc_allocator_init(allocator_api_t* api) {
     api->free = je_free_wrapper;
     api->aligned_alloc = je_aligned_alloc_wrapper;
     api->aligned_free = je_free_wrapper;
+    api->purge = je_purge;
     api->name = "jemalloc";
 }
 #else
@@ -113,6 +138,9 @@ static void mi_free_wrapper(void* ptr) { mi_free(ptr); }
 static void* mi_aligned_alloc_wrapper(size_t alignment, size_t size) {
     return mi_aligned_alloc(alignment, size);
 }
+static void mi_purge(void) {
+    mi_collect(true);
+}
 
 void mimalloc_allocator_init(allocator_api_t* api) {
     memset(api, 0, sizeof(allocator_api_t));
@@ -122,6 +150,7 @@ void mimalloc_allocator_init(allocator_api_t* api) {
     api->free = mi_free_wrapper;
     api->aligned_alloc = mi_aligned_alloc_wrapper;
     api->aligned_free = mi_free_wrapper;
+    api->purge = mi_purge;
     api->name = "mimalloc";
 }
 #else
@@ -133,11 +162,13 @@ void mimalloc_allocator_init(allocator_api_t* api) {
 
 #ifdef HAVE_TCMALLOC
 #include <gperftools/tcmalloc.h>
+#include <gperftools/malloc_extension_c.h>
 
 static void* tc_malloc_wrapper(size_t size) { return tc_malloc(size); }
 static void* tc_calloc_wrapper(size_t num, size_t size) { return tc_calloc(num, size); }
 static void* tc_realloc_wrapper(void* ptr, size_t size) { return tc_realloc(ptr, size); }
 static void tc_free_wrapper(void* ptr) { tc_free(ptr); }
+static void tc_purge(void) { MallocExtension_ReleaseFreeMemory(); }
 
 void tcmalloc_allocator_init(allocator_api_t* api) {
     memset(api, 0, sizeof(allocator_api_t));
@@ -145,6 +176,7 @@ void tcmalloc_allocator_init(allocator_api_t* api) {
     api->calloc = tc_calloc_wrapper;
     api->realloc = tc_realloc_wrapper;
     api->free = tc_free_wrapper;
+    api->purge = tc_purge;
     api->name = "tcmalloc";
 }
 #else
@@ -153,3 +185,102 @@ void tcmalloc_allocator_init(allocator_api_t* api) {
     api->name = "tcmalloc (unavailable)";
 }
 #endif
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Every block is its own anonymous mapping. The header in front of the user
+ * pointer records the mapping so free and realloc need no lookup. */
+typedef struct {
+    void* base;
+    size_t length;
+} mmap_header_t;
+
+#define MMAP_HEADER_SIZE 16
+
+static size_t mmap_page_size(void) {
+    static size_t page_size = 0;
+    if (page_size == 0) page_size = (size_t)sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+static size_t mmap_round_up(size_t size) {
+    size_t page = mmap_page_size();
+    return (size + page - 1) & ~(page - 1);
+}
+
+static void* mmap_place(void* base, size_t length, char* user) {
+    mmap_header_t* header = (mmap_header_t*)(user - MMAP_HEADER_SIZE);
+    header->base = base;
+    header->length = length;
+    return user;
+}
+
+static void* mmap_malloc(size_t size) {
+    size_t length = mmap_round_up(size + MMAP_HEADER_SIZE);
+    void* base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return NULL;
+    return mmap_place(base, length, (char*)base + MMAP_HEADER_SIZE);
+}
+
+static void* mmap_calloc(size_t num, size_t size) {
+    if (size && num > (size_t)-1 / size) return NULL;
+    return mmap_malloc(num * size);
+}
+
+static void mmap_free(void* ptr) {
+    if (!ptr) return;
+    mmap_header_t* header = (mmap_header_t*)((char*)ptr - MMAP_HEADER_SIZE);
+    munmap(header->base, header->length);
+}
+
+static void* mmap_realloc(void* ptr, size_t size) {
+    if (!ptr) return mmap_malloc(size);
+
+    mmap_header_t* header = (mmap_header_t*)((char*)ptr - MMAP_HEADER_SIZE);
+    size_t offset = (size_t)((char*)ptr - (char*)header->base);
+    size_t length = mmap_round_up(size + offset);
+    if (length <= header->length) return ptr;
+
+#ifdef __linux__
+    void* base = mremap(header->base, header->length, length, MREMAP_MAYMOVE);
+    if (base == MAP_FAILED) return NULL;
+    return mmap_place(base, length, (char*)base + offset);
+#else
+    void* new_ptr = mmap_malloc(size);
+    if (!new_ptr) return NULL;
+    memcpy(new_ptr, ptr, header->length - offset);
+    mmap_free(ptr);
+    return new_ptr;
+#endif
+}
+
+static void* mmap_aligned_alloc(size_t alignment, size_t size) {
+    if (alignment <= MMAP_HEADER_SIZE) return mmap_malloc(size);
+
+    size_t length = mmap_round_up(size + alignment + MMAP_HEADER_SIZE);
+    void* base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return NULL;
+
+    uintptr_t user = ((uintptr_t)base + MMAP_HEADER_SIZE + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    return mmap_place(base, length, (char*)user);
+}
+
+void mmap_allocator_init(allocator_api_t* api) {
+    memset(api, 0, sizeof(allocator_api_t));
+    api->malloc = mmap_malloc;
+    api->calloc = mmap_calloc;
+    api->realloc = mmap_realloc;
+    api->free = mmap_free;
+    api->aligned_alloc = mmap_aligned_alloc;
+    api->aligned_free = mmap_free;
+    api->name = "mmap";
+}
+#else
+void mmap_allocator_init(allocator_api_t* api) {
+    memset(api, 0, sizeof(allocator_api_t));
+    api->name = "mmap (unavailable)";
+}
+#endif
@@ -12,6 +12,7 @@ typedef struct {
     void (*aligned_free)(void* ptr);
     int (*init)(void);
     void (*cleanup)(void);
+    void (*purge)(void);        /* optional: return cached free memory to the OS */
     const char* name;
 } allocator_api_t;
 
@@ -21,4 +22,8 @@ void jemalloc_allocator_init(allocator_api_t* api);
 void mimalloc_allocator_init(allocator_api_t* api);
 void tcmalloc_allocator_init(allocator_api_t* api);
 
+/* One mmap per allocation, munmap on free. Not registered with the harness;
+ * the large-allocation benchmarks use it as their reference. */
+void mmap_allocator_init(allocator_api_t* api);
+
 #endif
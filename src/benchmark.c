@@ -2,12 +2,13 @@
 #include "metrics/timer.h"
 #include "metrics/memory_stats.h"
 #include "metrics/results.h"
+#include "metrics/system_info.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define MAX_ALLOCATORS 16
-#define MAX_BENCHMARKS 64
+#define MAX_BENCHMARKS 128
 
 static allocator_info_t allocators[MAX_ALLOCATORS];
 static int allocator_count = 0;
@@ -15,6 +16,13 @@ static int allocator_count = 0;
 static benchmark_t benchmarks[MAX_BENCHMARKS];
 static int benchmark_count = 0;
 
+static benchmark_options_t options = { 0 };
+
+static benchmark_config_t sweep_configs[MAX_BENCHMARKS];
+static int sweep_config_count = 0;
+
+static volatile uint64_t do_not_optimize_sink;
+
 void benchmark_init(void) {
     allocator_count = 0;
     benchmark_count = 0;
@@ -40,12 +48,143 @@ allocator_info_t* benchmark_get_allocator(int index) {
     return &allocators[index];
 }
 
+void benchmark_purge_allocators(void) {
+    for (int i = 0; i < allocator_count; i++) {
+        if (allocators[i].api.purge) allocators[i].api.purge();
+    }
+}
+
+void benchmark_set_options(const benchmark_options_t* opts) {
+    if (opts) {
+        options = *opts;
+    } else {
+        memset(&options, 0, sizeof(options));
+    }
+}
+
+const benchmark_options_t* benchmark_get_options(void) {
+    return &options;
+}
+
+void benchmark_make_config(const benchmark_t* bench, benchmark_config_t* config) {
+    static const benchmark_config_t fallback = BENCHMARK_DEFAULT_CONFIG;
+
+    *config = bench->default_config ? *(const benchmark_config_t*)bench->default_config : fallback;
+
+    if (options.iterations > 0) config->iterations = options.iterations;
+    if (options.sample_interval_ms > 0) config->sample_interval_ms = options.sample_interval_ms;
+    if (options.size_dist) config->size_dist = options.size_dist;
+}
+
+static int find_param(const char* params, const char* key, char* value, size_t value_size) {
+    if (!params || !key) return 0;
+
+    size_t key_len = strlen(key);
+    const char* p = params;
+
+    while (*p) {
+        while (*p == ',' || *p == ' ') p++;
+        const char* end = strchr(p, ',');
+        if (!end) end = p + strlen(p);
+
+        if ((size_t)(end - p) > key_len && strncmp(p, key, key_len) == 0 && p[key_len] == '=') {
+            size_t len = (size_t)(end - (p + key_len + 1));
+            if (len >= value_size) len = value_size - 1;
+            memcpy(value, p + key_len + 1, len);
+            value[len] = '\0';
+            return 1;
+        }
+        p = end;
+    }
+
+    return 0;
+}
+
+static int lookup_param(const benchmark_config_t* config, const char* key,
+                        char* value, size_t value_size) {
+    if (find_param(options.params, key, value, value_size)) return 1;
+    return config && find_param(config->params, key, value, value_size);
+}
+
+double benchmark_param_double(const benchmark_config_t* config, const char* key,
+                              double default_value) {
+    char value[64];
+    if (!lookup_param(config, key, value, sizeof(value))) return default_value;
+
+    char* end = NULL;
+    double parsed = strtod(value, &end);
+    if (end == value) return default_value;
+
+    switch (*end) {
+        case 'k': case 'K': parsed *= 1024.0; break;
+        case 'm': case 'M': parsed *= 1024.0 * 1024.0; break;
+        case 'g': case 'G': parsed *= 1024.0 * 1024.0 * 1024.0; break;
+        default: break;
+    }
+    return parsed;
+}
+
+size_t benchmark_param_size(const benchmark_config_t* config, const char* key,
+                            size_t default_value) {
+    double value = benchmark_param_double(config, key, (double)default_value);
+    return value > 0 ? (size_t)value : 0;
+}
+
+void benchmark_result_add_metric(benchmark_result_t* result, const char* name, double value) {
+    if (result->extra_metric_count >= MAX_EXTRA_METRICS) return;
+
+    benchmark_metric_t* metric = &result->extra_metrics[result->extra_metric_count++];
+    strncpy(metric->name, name, MAX_METRIC_NAME - 1);
+    metric->name[MAX_METRIC_NAME - 1] = '\0';
+    metric->value = value;
+}
+
+void benchmark_do_not_optimize(uint64_t value) {
+    do_not_optimize_sink = value;
+}
+
 void benchmark_register(const benchmark_t* bench) {
     if (benchmark_count >= MAX_BENCHMARKS) return;
     benchmarks[benchmark_count] = *bench;
     benchmark_count++;
 }
 
+static void register_sweep_point(const char* name_prefix, const char* description,
+                                 int (*run)(allocator_api_t*, benchmark_result_t*, void*),
+                                 int thread_count) {
+    if (sweep_config_count >= MAX_BENCHMARKS) return;
+
+    benchmark_config_t* config = &sweep_configs[sweep_config_count++];
+    *config = (benchmark_config_t)BENCHMARK_DEFAULT_CONFIG;
+    config->thread_count = thread_count;
+
+    benchmark_t bench;
+    memset(&bench, 0, sizeof(bench));
+    snprintf(bench.name, sizeof(bench.name), "%s_%d", name_prefix, thread_count);
+    snprintf(bench.description, sizeof(bench.description), "%s (%d thread%s)",
+             description, thread_count, thread_count == 1 ? "" : "s");
+    bench.run = run;
+    bench.default_config = config;
+    benchmark_register(&bench);
+}
+
+/* Registers one benchmark per thread count: powers of two up to the number of
+ * online CPUs, the CPU count itself, then 2x, 4x, ... up to max_oversubscription x. */
+void benchmark_register_thread_sweep(const char* name_prefix, const char* description,
+                                     int (*run)(allocator_api_t*, benchmark_result_t*, void*),
+                                     int max_oversubscription) {
+    int cpus = system_info_logical_cpus();
+
+    for (int n = 1; n < cpus; n *= 2) {
+        register_sweep_point(name_prefix, description, run, n);
+    }
+    register_sweep_point(name_prefix, description, run, cpus);
+
+    for (int factor = 2; factor <= max_oversubscription; factor *= 2) {
+        register_sweep_point(name_prefix, description, run, cpus * factor);
+    }
+}
+
 int benchmark_get_count(void) {
     return benchmark_count;
 }
@@ -96,12 +235,21 @@ int benchmark_run_single(const char* allocator_name, const char* benchmark_name,
 
     memset(result, 0, sizeof(benchmark_result_t));
 
+    benchmark_config_t config;
+    benchmark_make_config(bench, &config);
+
+    allocator_api_t api;
+    touch_api_wrap(&api, &alloc->api, options.touch);
+
+    benchmark_purge_allocators();
     memory_stats_reset();
+    size_t faults_before = get_page_faults();
     timer_start();
 
-    int ret = bench->run(&alloc->api, result, bench->default_config);
+    int ret = bench->run(&api, result, &config);
 
     result->total_time_ms = timer_end_ms();
+    result->page_faults = get_page_faults() - faults_before;
 
     memory_stats_get(&result->peak_rss_kb, &result->current_rss_kb);
 
@@ -121,12 +269,17 @@ void benchmark_print_result(const char* benchmark_name, const char* allocator_na
     printf("  Alloc ops/sec:     %.2f M\n", result->alloc_ops_per_sec / 1e6);
     printf("  Free ops/sec:      %.2f M\n", result->free_ops_per_sec / 1e6);
     printf("  Total ops/sec:     %.2f M\n", result->total_ops_per_sec / 1e6);
-    printf("  Avg alloc time:    %.2f ns\n", result->avg_alloc_time_ns);
+    if (result->avg_alloc_time_ns != BENCHMARK_METRIC_NA)
+        printf("  Avg alloc time:    %.2f ns\n", result->avg_alloc_time_ns);
     if (result->p99_alloc_time_ns != BENCHMARK_METRIC_NA)
         printf("  P99 alloc time:    %.2f ns\n", result->p99_alloc_time_ns);
     printf("  Peak RSS:          %zu KB\n", result->peak_rss_kb);
+    printf("  Page faults:       %zu\n", result->page_faults);
     if (result->fragmentation_ratio != BENCHMARK_METRIC_NA)
         printf("  Fragmentation:     %.3f\n", result->fragmentation_ratio);
+    for (int i = 0; i < result->extra_metric_count; i++) {
+        printf("  %-18s %.2f\n", result->extra_metrics[i].name, result->extra_metrics[i].value);
+    }
 }
 
 int benchmark_run_all(const char* output_dir) {
@@ -142,9 +295,15 @@ int benchmark_run_all(const char* output_dir) {
         printf("  [%d] %s - %s\n", i + 1, benchmarks[i].name, benchmarks[i].description);
     }
 
-    results_context_t results_ctx;
+    static results_context_t results_ctx;
     results_init(&results_ctx, output_dir);
 
+    printf("\nMachine: %s (%d cores / %d threads), governor %s, turbo %s, THP %s\n",
+           results_ctx.system.cpu_model, results_ctx.system.physical_cores,
+           results_ctx.system.logical_cpus, results_ctx.system.governor,
+           results_ctx.system.turbo, results_ctx.system.thp_enabled);
+    system_info_print_warnings(&results_ctx.system);
+
     printf("\nRunning benchmarks...\n");
     printf("----------------------------------------\n");
 
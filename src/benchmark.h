@@ -4,10 +4,13 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "allocator_api.h"
+#include "touch.h"
 
 #define MAX_ALLOCATOR_NAME 32
 #define MAX_BENCHMARK_NAME 64
-#define MAX_THREADS 16
+#define MAX_SERIES_SAMPLES 256
+#define MAX_EXTRA_METRICS 48
+#define MAX_METRIC_NAME 32
 
 typedef struct {
     char name[MAX_ALLOCATOR_NAME];
@@ -15,6 +18,27 @@ typedef struct {
     int available;
 } allocator_info_t;
 
+/* Fixed-width time slices; values[i] is the ops/sec rate over slice i. */
+typedef struct {
+    double interval_ms;
+    int count;
+    float values[MAX_SERIES_SAMPLES];
+} benchmark_series_t;
+
+/* A gauge read every interval_ops operations; values[i] is the reading taken
+ * after (i + 1) * interval_ops of them. */
+typedef struct {
+    double interval_ops;
+    int count;
+    float values[MAX_SERIES_SAMPLES];
+} benchmark_gauge_series_t;
+
+/* Benchmark-specific metric that has no dedicated field in benchmark_result_t. */
+typedef struct {
+    char name[MAX_METRIC_NAME];
+    double value;
+} benchmark_metric_t;
+
 typedef struct {
     double alloc_ops_per_sec;
     double free_ops_per_sec;
@@ -27,12 +51,18 @@ typedef struct {
     double p99_alloc_time_ns;
     size_t peak_rss_kb;
     size_t current_rss_kb;
+    size_t page_faults;
     double fragmentation_ratio;
     size_t total_allocated_bytes;
     size_t total_requested_bytes;
     double total_time_ms;
     size_t operations_count;
     int thread_count;
+    benchmark_series_t throughput_series;
+    benchmark_gauge_series_t fragmentation_series;
+    benchmark_series_t rss_series; /* RSS in KB at the end of each slice */
+    benchmark_metric_t extra_metrics[MAX_EXTRA_METRICS];
+    int extra_metric_count;
 } benchmark_result_t;
 
 typedef struct {
@@ -48,14 +78,36 @@ typedef struct {
     size_t max_size;
     int thread_count;
     unsigned int seed;
+    double sample_interval_ms;
+    const char* params;
+    const char* size_dist;
 } benchmark_config_t;
 
+/* Harness-wide settings applied on top of every benchmark's default config. */
+typedef struct {
+    size_t iterations;              /* 0 keeps each benchmark's own count */
+    double sample_interval_ms;
+    const char* params;
+    const char* size_dist;
+    touch_mode_t touch;
+} benchmark_options_t;
+
 void benchmark_init(void);
 void benchmark_register_allocator(const char* name, allocator_api_t* api);
 int benchmark_get_allocator_count(void);
 allocator_info_t* benchmark_get_allocator(int index);
+/* Returns every registered allocator's cached free memory to the OS so the
+ * next run's RSS starts from a clean baseline. */
+void benchmark_purge_allocators(void);
+
+void benchmark_set_options(const benchmark_options_t* options);
+const benchmark_options_t* benchmark_get_options(void);
+void benchmark_make_config(const benchmark_t* bench, benchmark_config_t* config);
 
 void benchmark_register(const benchmark_t* bench);
+void benchmark_register_thread_sweep(const char* name_prefix, const char* description,
+                                     int (*run)(allocator_api_t*, benchmark_result_t*, void*),
+                                     int max_oversubscription);
 int benchmark_get_count(void);
 benchmark_t* benchmark_get(int index);
 
@@ -65,6 +117,19 @@ int benchmark_run_single(const char* allocator_name, const char* benchmark_name,
 void benchmark_print_result(const char* benchmark_name, const char* allocator_name,
                            const benchmark_result_t* result);
 
+void benchmark_result_add_metric(benchmark_result_t* result, const char* name, double value);
+
+/* Consumes a value computed from benchmark data so the work producing it
+ * cannot be optimized away, without reporting it anywhere. */
+void benchmark_do_not_optimize(uint64_t value);
+
+/* "key=value,key=value" parameters; harness (-p) values win over the
+ * benchmark's own defaults. Sizes accept K/M/G suffixes. */
+size_t benchmark_param_size(const benchmark_config_t* config, const char* key,
+                            size_t default_value);
+double benchmark_param_double(const benchmark_config_t* config, const char* key,
+                              double default_value);
+
 #define BENCHMARK_METRIC_NA (-1.0)
 
 #define BENCHMARK_DEFAULT_CONFIG { \
@@ -72,7 +137,10 @@ void benchmark_print_result(const char* benchmark_name, const char* allocator_na
     .min_size = 8, \
     .max_size = 4096, \
     .thread_count = 1, \
-    .seed = 42 \
+    .seed = 42, \
+    .sample_interval_ms = 0, \
+    .params = NULL, \
+    .size_dist = NULL \
 }
 
 #define BENCHMARK_REGISTER(name, desc, run_func, config) \
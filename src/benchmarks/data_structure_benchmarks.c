@@ -6,6 +6,7 @@
 #include "stack.h"
 #include "timer.h"
 #include "memory_stats.h"
+#include "timeseries.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -61,6 +62,14 @@ void register_data_structure_benchmarks(void) {
         .default_config = &default_config
     };
     benchmark_register(&bench5);
+
+    static benchmark_t bench6 = {
+        .name = "traversal_locality",
+        .description = "Walk list/tree/hash built on an aged heap (ns per node)",
+        .run = bench_traversal_locality,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench6);
 }
 
 int bench_vector_operations(allocator_api_t* api, benchmark_result_t* result, void* config) {
@@ -79,6 +88,9 @@ int bench_vector_operations(allocator_api_t* api, benchmark_result_t* result, vo
     double total_pop_time = 0;
     size_t total_requested = 0;
 
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
     int* values = malloc(iterations * sizeof(int));
     for (size_t i = 0; i < iterations; i++) {
         values[i] = (int)(xorshift32(&seed));
@@ -89,6 +101,7 @@ int bench_vector_operations(allocator_api_t* api, benchmark_result_t* result, vo
         hr_timer_start(&timer);
         vector_push_back(&vec, &values[i]);
         total_push_time += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
         total_requested += sizeof(int);
     }
 
@@ -98,8 +111,11 @@ int bench_vector_operations(allocator_api_t* api, benchmark_result_t* result, vo
         hr_timer_start(&timer);
         vector_pop_back(&vec, &dummy);
         total_pop_time += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
     }
 
+    series_sampler_finish(&sampler);
+
     vector_destroy(&vec);
     free(values);
 
@@ -136,6 +152,9 @@ int bench_linked_list_operations(allocator_api_t* api, benchmark_result_t* resul
     double total_pop_time = 0;
     size_t total_requested = 0;
 
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
     for (size_t i = 0; i < iterations; i++) {
         int* val = api->malloc(sizeof(int));
         *val = (int)(xorshift32(&seed));
@@ -144,6 +163,7 @@ int bench_linked_list_operations(allocator_api_t* api, benchmark_result_t* resul
         hr_timer_start(&timer);
         linked_list_push_back(&list, val);
         total_push_time += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
         total_requested += sizeof(int) + sizeof(linked_list_node_t);
     }
 
@@ -152,9 +172,12 @@ int bench_linked_list_operations(allocator_api_t* api, benchmark_result_t* resul
         hr_timer_start(&timer);
         int* val = linked_list_pop_back(&list);
         total_pop_time += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
         if (val) api->free(val);
     }
 
+    series_sampler_finish(&sampler);
+
     linked_list_destroy(&list);
 
     result->operations_count = iterations * 2;
@@ -194,6 +217,9 @@ int bench_binary_tree_operations(allocator_api_t* api, benchmark_result_t* resul
     double total_remove_time = 0;
     size_t total_requested = 0;
 
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
     int* keys = malloc(iterations * sizeof(int));
     for (size_t i = 0; i < iterations; i++) {
         keys[i] = (int)(xorshift32(&seed));
@@ -204,6 +230,7 @@ int bench_binary_tree_operations(allocator_api_t* api, benchmark_result_t* resul
         hr_timer_start(&timer);
         binary_tree_insert(&tree, (void*)(intptr_t)keys[i], (void*)(intptr_t)i);
         total_insert_time += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
         total_requested += sizeof(binary_tree_node_t);
     }
 
@@ -212,8 +239,11 @@ int bench_binary_tree_operations(allocator_api_t* api, benchmark_result_t* resul
         hr_timer_start(&timer);
         binary_tree_remove(&tree, (void*)(intptr_t)keys[i]);
         total_remove_time += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
     }
 
+    series_sampler_finish(&sampler);
+
     binary_tree_destroy(&tree);
     free(keys);
 
@@ -250,6 +280,9 @@ int bench_hash_table_operations(allocator_api_t* api, benchmark_result_t* result
     double total_lookup_time = 0;
     size_t total_requested = 0;
 
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
     for (size_t i = 0; i < iterations; i++) {
         void* key = (void*)(intptr_t)(xorshift32(&seed));
 
@@ -257,6 +290,7 @@ int bench_hash_table_operations(allocator_api_t* api, benchmark_result_t* result
         hr_timer_start(&timer);
         hash_table_insert(&table, key, (void*)(intptr_t)i);
         total_insert_time += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
         total_requested += sizeof(hash_table_entry_t);
     }
 
@@ -268,8 +302,11 @@ int bench_hash_table_operations(allocator_api_t* api, benchmark_result_t* result
         hr_timer_start(&timer);
         hash_table_get(&table, key);
         total_lookup_time += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
     }
 
+    series_sampler_finish(&sampler);
+
     hash_table_destroy(&table);
 
     result->operations_count = iterations * 2;
@@ -304,6 +341,9 @@ int bench_stack_operations(allocator_api_t* api, benchmark_result_t* result, voi
     double total_pop_time = 0;
     size_t total_requested = 0;
 
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
     for (size_t i = 0; i < iterations; i++) {
         int* val = api->malloc(sizeof(int));
         *val = (int)(xorshift32(&seed));
@@ -312,6 +352,7 @@ int bench_stack_operations(allocator_api_t* api, benchmark_result_t* result, voi
         hr_timer_start(&timer);
         stack_push(&stack, val);
         total_push_time += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
         total_requested += sizeof(int) + sizeof(stack_node_t);
     }
 
@@ -320,9 +361,12 @@ int bench_stack_operations(allocator_api_t* api, benchmark_result_t* result, voi
         hr_timer_start(&timer);
         int* val = stack_pop(&stack);
         total_pop_time += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
         if (val) api->free(val);
     }
 
+    series_sampler_finish(&sampler);
+
     stack_destroy(&stack);
 
     result->operations_count = iterations * 2;
@@ -341,3 +385,173 @@ int bench_stack_operations(allocator_api_t* api, benchmark_result_t* result, voi
 
     return 0;
 }
+
+/* Payload hung off every node, so a visit touches two allocator blocks. */
+typedef struct {
+    uint64_t value;
+    uint64_t pad[3];
+} traversal_payload_t;
+
+static void sum_tree_payload(binary_tree_node_t* node, void* ctx) {
+    *(uint64_t*)ctx += ((traversal_payload_t*)node->value)->value;
+}
+
+int bench_traversal_locality(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+
+    size_t nodes = benchmark_param_size(cfg, "nodes", 100000);
+    size_t filler_count = benchmark_param_size(cfg, "fillers", nodes * 2);
+    if (nodes < 1) nodes = 1;
+
+    size_t passes = cfg->iterations / nodes;
+    if (passes < 1) passes = 1;
+
+    unsigned int seed = cfg->seed;
+    void** fillers = calloc(filler_count + 1, sizeof(void*));
+    traversal_payload_t** payloads = calloc(nodes * 3, sizeof(traversal_payload_t*));
+    if (!fillers || !payloads) {
+        free(fillers);
+        free(payloads);
+        return -1;
+    }
+
+    linked_list_t list;
+    binary_tree_t tree;
+    hash_table_t table;
+    if (linked_list_init(&list, api) != 0) {
+        free(fillers);
+        free(payloads);
+        return -1;
+    }
+    if (binary_tree_init(&tree, compare_ints, api) != 0) {
+        linked_list_destroy(&list);
+        free(fillers);
+        free(payloads);
+        return -1;
+    }
+    if (hash_table_init(&table, hash_int, key_equal_int, api) != 0) {
+        linked_list_destroy(&list);
+        binary_tree_destroy(&tree);
+        free(fillers);
+        free(payloads);
+        return -1;
+    }
+
+    /* Age the heap: fill it with mixed-size blocks, then punch random holes. */
+    for (size_t i = 0; i < filler_count; i++) {
+        fillers[i] = api->malloc(8 + xorshift32(&seed) % 505);
+    }
+    for (size_t i = 0; i < filler_count; i++) {
+        if (fillers[i] && xorshift32(&seed) % 2 == 0) {
+            api->free(fillers[i]);
+            fillers[i] = NULL;
+        }
+    }
+
+    /* Build all three structures interleaved with unrelated allocation churn,
+     * the way long-lived structures grow in a real program. */
+    int ok = 1;
+    size_t payload_count = 0;
+    for (size_t i = 0; i < nodes && ok; i++) {
+        for (int s = 0; s < 3; s++) {
+            traversal_payload_t* payload = api->malloc(sizeof(traversal_payload_t));
+            if (!payload) {
+                ok = 0;
+                break;
+            }
+            payload->value = i;
+            payloads[payload_count++] = payload;
+
+            int key = (int)(xorshift32(&seed) & 0x3fffffff);
+            if (s == 0)
+                ok = linked_list_push_back(&list, payload) == 0;
+            else if (s == 1)
+                ok = binary_tree_insert(&tree, (void*)(intptr_t)key, payload) != NULL;
+            else
+                ok = hash_table_insert(&table, (void*)(intptr_t)key, payload) == 0;
+        }
+
+        if (filler_count > 0) {
+            size_t slot = xorshift32(&seed) % filler_count;
+            if (fillers[slot]) {
+                api->free(fillers[slot]);
+                fillers[slot] = NULL;
+            } else {
+                fillers[slot] = api->malloc(8 + xorshift32(&seed) % 505);
+            }
+        }
+    }
+
+    uint64_t checksum = 0;
+    size_t list_visits = 0, tree_visits = 0, hash_visits = 0;
+    double list_ns = 0, tree_ns = 0, hash_ns = 0;
+
+    if (ok) {
+        double start = timer_now_ns();
+        for (size_t pass = 0; pass < passes; pass++) {
+            for (linked_list_node_t* node = list.head; node; node = node->next) {
+                checksum += ((traversal_payload_t*)node->data)->value;
+                list_visits++;
+            }
+        }
+        list_ns = timer_now_ns() - start;
+
+        start = timer_now_ns();
+        for (size_t pass = 0; pass < passes; pass++) {
+            binary_tree_inorder_traverse(&tree, sum_tree_payload, &checksum);
+            tree_visits += binary_tree_size(&tree);
+        }
+        tree_ns = timer_now_ns() - start;
+
+        start = timer_now_ns();
+        for (size_t pass = 0; pass < passes; pass++) {
+            for (size_t b = 0; b < table.capacity; b++) {
+                for (hash_table_entry_t* entry = table.buckets[b]; entry; entry = entry->next) {
+                    checksum += ((traversal_payload_t*)entry->value)->value;
+                    hash_visits++;
+                }
+            }
+        }
+        hash_ns = timer_now_ns() - start;
+        benchmark_do_not_optimize(checksum);
+    }
+
+    linked_list_destroy(&list);
+    binary_tree_destroy(&tree);
+    hash_table_destroy(&table);
+    for (size_t i = 0; i < payload_count; i++) {
+        api->free(payloads[i]);
+    }
+    for (size_t i = 0; i < filler_count; i++) {
+        if (fillers[i]) api->free(fillers[i]);
+    }
+    free(payloads);
+    free(fillers);
+
+    if (!ok || list_visits == 0) return -1;
+
+    size_t visits = list_visits + tree_visits + hash_visits;
+    double total_ns = list_ns + tree_ns + hash_ns;
+
+    result->operations_count = visits;
+    result->thread_count = 1;
+    result->total_ops_per_sec = (double)visits / (total_ns / 1e9);
+    result->avg_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->total_requested_bytes = payload_count * sizeof(traversal_payload_t) +
+                                    nodes * (sizeof(linked_list_node_t) + sizeof(binary_tree_node_t) +
+                                             sizeof(hash_table_entry_t));
+    result->total_allocated_bytes = result->total_requested_bytes;
+    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+    benchmark_result_add_metric(result, "list_ns_per_node", list_ns / (double)list_visits);
+    benchmark_result_add_metric(result, "tree_ns_per_node", tree_visits ? tree_ns / (double)tree_visits : BENCHMARK_METRIC_NA);
+    benchmark_result_add_metric(result, "hash_ns_per_node", hash_visits ? hash_ns / (double)hash_visits : BENCHMARK_METRIC_NA);
+    benchmark_result_add_metric(result, "nodes", (double)nodes);
+    benchmark_result_add_metric(result, "passes", (double)passes);
+
+    return 0;
+}
@@ -10,5 +10,6 @@ int bench_linked_list_operations(allocator_api_t* api, benchmark_result_t* resul
 int bench_binary_tree_operations(allocator_api_t* api, benchmark_result_t* result, void* config);
 int bench_hash_table_operations(allocator_api_t* api, benchmark_result_t* result, void* config);
 int bench_stack_operations(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_traversal_locality(allocator_api_t* api, benchmark_result_t* result, void* config);
 
 #endif
@@ -1,6 +1,10 @@
 #include "fragmentation_benchmarks.h"
 #include "timer.h"
 #include "memory_stats.h"
+#include "timeseries.h"
+#include "threading.h"
+#include "size_dist.h"
+#include "lifetime_model.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,6 +20,75 @@ static unsigned int xorshift32(unsigned int* state) {
     return x;
 }
 
+#define FRAG_SERIES_POINTS 128
+#define FRAG_MIN_LIVE_BYTES (64 * 1024)
+
+/* Fragmentation as the heap actually shows it: resident memory (relative to
+ * the harness baseline) divided by the bytes the benchmark still holds. */
+typedef struct {
+    benchmark_gauge_series_t* series;
+    size_t live_bytes;
+    size_t ops;
+    size_t next_sample;
+    double last_ratio;
+    double peak_ratio;
+    double ratio_sum;
+    int ratio_samples;
+    int accumulate;
+} frag_tracker_t;
+
+static void frag_tracker_init(frag_tracker_t* tracker, benchmark_result_t* result, size_t expected_ops) {
+    memset(tracker, 0, sizeof(frag_tracker_t));
+    size_t interval = expected_ops / FRAG_SERIES_POINTS;
+    if (interval < 1) interval = 1;
+
+    tracker->series = &result->fragmentation_series;
+    gauge_series_init(tracker->series, (double)interval);
+    tracker->next_sample = interval;
+    tracker->last_ratio = BENCHMARK_METRIC_NA;
+}
+
+/* Returns BENCHMARK_METRIC_NA while too little is live for the ratio to mean anything. */
+static double frag_tracker_sample(frag_tracker_t* tracker) {
+    size_t rss_kb = memory_stats_sample();
+    if (tracker->live_bytes < FRAG_MIN_LIVE_BYTES) return BENCHMARK_METRIC_NA;
+
+    double ratio = (double)rss_kb * 1024.0 / (double)tracker->live_bytes;
+    tracker->last_ratio = ratio;
+    if (ratio > tracker->peak_ratio) tracker->peak_ratio = ratio;
+    if (tracker->accumulate) {
+        tracker->ratio_sum += ratio;
+        tracker->ratio_samples++;
+    }
+    return ratio;
+}
+
+static void frag_tracker_tick(frag_tracker_t* tracker) {
+    if (++tracker->ops < tracker->next_sample) return;
+
+    double ratio = frag_tracker_sample(tracker);
+    gauge_series_push(tracker->series, ratio == BENCHMARK_METRIC_NA ? 0.0f : (float)ratio);
+    tracker->next_sample = tracker->ops + (size_t)tracker->series->interval_ops;
+}
+
+static void frag_tracker_alloc(frag_tracker_t* tracker, size_t size) {
+    tracker->live_bytes += size;
+    frag_tracker_tick(tracker);
+}
+
+static void frag_tracker_free(frag_tracker_t* tracker, size_t size) {
+    tracker->live_bytes -= size;
+    frag_tracker_tick(tracker);
+}
+
+static double frag_tracker_mean(const frag_tracker_t* tracker) {
+    return tracker->ratio_samples ? tracker->ratio_sum / tracker->ratio_samples : BENCHMARK_METRIC_NA;
+}
+
+static double mean_or_na(double sum, int count) {
+    return count ? sum / count : BENCHMARK_METRIC_NA;
+}
+
 void register_fragmentation_benchmarks(void) {
     static benchmark_t bench1 = {
         .name = "fragmentation_pattern",
@@ -35,11 +108,51 @@ void register_fragmentation_benchmarks(void) {
 
     static benchmark_t bench3 = {
         .name = "larson",
-        .description = "Larson benchmark (allocation density)",
+        .description = "Larson server simulation (threads inherit objects across rounds)",
         .run = bench_larson,
         .default_config = &default_config
     };
     benchmark_register(&bench3);
+
+    static benchmark_t bench4 = {
+        .name = "lifetime_fixed",
+        .description = "Expiry-queue churn, every object lives a fixed number of allocations",
+        .run = bench_lifetime_fixed,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench4);
+
+    static benchmark_t bench5 = {
+        .name = "lifetime_exp",
+        .description = "Expiry-queue churn, exponential lifetimes",
+        .run = bench_lifetime_exponential,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench5);
+
+    static benchmark_t bench6 = {
+        .name = "lifetime_gen",
+        .description = "Expiry-queue churn, generational lifetimes (most die young)",
+        .run = bench_lifetime_generational,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench6);
+
+    static benchmark_t bench7 = {
+        .name = "frag_interleaved",
+        .description = "Interleaved small/large, free the large, refill with small then large (RSS / live series)",
+        .run = bench_frag_interleaved,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench7);
+
+    static benchmark_t bench8 = {
+        .name = "frag_swiss_cheese",
+        .description = "Punch random holes in a full heap, then request larger blocks (RSS / live series)",
+        .run = bench_frag_swiss_cheese,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench8);
 }
 
 int bench_fragmentation_pattern(allocator_api_t* api, benchmark_result_t* result, void* config) {
@@ -68,15 +181,25 @@ int bench_fragmentation_pattern(allocator_api_t* api, benchmark_result_t* result
     hr_timer_t timer;
     double total_time_ns = 0;
     size_t total_requested = 0;
+
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
     size_t active_count = 0;
 
+    /* Round 0 builds the live set; the reported ratio averages rounds 1-3. */
+    frag_tracker_t frag;
+    frag_tracker_init(&frag, result, iterations * 4 + iterations);
+
     for (size_t round = 0; round < 4; round++) {
+        frag.accumulate = round > 0;
         for (size_t i = 0; i < iterations; i++) {
             if (ptrs[i] && xorshift32(&seed) % 3 == 0) {
                 hr_timer_init(&timer);
                 hr_timer_start(&timer);
                 api->free(ptrs[i]);
                 total_time_ns += hr_timer_end(&timer);
+                series_sampler_add(&sampler, 1);
+                frag_tracker_free(&frag, alloc_sizes[i]);
                 ptrs[i] = NULL;
                 active_count--;
             }
@@ -89,25 +212,20 @@ int bench_fragmentation_pattern(allocator_api_t* api, benchmark_result_t* result
                 hr_timer_start(&timer);
                 ptrs[i] = api->malloc(size);
                 total_time_ns += hr_timer_end(&timer);
+                series_sampler_add(&sampler, 1);
 
                 if (ptrs[i]) {
                     alloc_sizes[i] = size;
                     active_count++;
+                    frag_tracker_alloc(&frag, size);
                 }
             }
         }
     }
 
-    size_t peak_memory = 0;
-    size_t current_memory = 0;
-    for (size_t i = 0; i < iterations; i++) {
-        if (ptrs[i]) {
-            current_memory += alloc_sizes[i];
-            if (current_memory > peak_memory) {
-                peak_memory = current_memory;
-            }
-        }
-    }
+    series_sampler_finish(&sampler);
+    frag_tracker_sample(&frag);
+    size_t live_at_end = frag.live_bytes;
 
     for (size_t i = 0; i < iterations; i++) {
         if (ptrs[i]) {
@@ -128,15 +246,23 @@ int bench_fragmentation_pattern(allocator_api_t* api, benchmark_result_t* result
     result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
     result->total_requested_bytes = total_requested;
     result->total_allocated_bytes = total_requested;
-    result->fragmentation_ratio = 1.0 + (double)(peak_memory - total_requested / 4) / (double)peak_memory;
+    result->fragmentation_ratio = frag_tracker_mean(&frag);
+
+    benchmark_result_add_metric(result, "frag_peak", frag.peak_ratio);
+    benchmark_result_add_metric(result, "frag_final", frag.last_ratio);
+    benchmark_result_add_metric(result, "live_kb_at_end", (double)live_at_end / 1024.0);
+    benchmark_result_add_metric(result, "live_objects_at_end", (double)active_count);
 
     return 0;
 }
 
+/* Interleaved 16/1024 byte objects, free every small one, then ask for
+ * large blocks that cannot fit in the 16-byte holes. */
 int bench_worst_case_fragmentation(allocator_api_t* api, benchmark_result_t* result, void* config) {
     benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
 
-    size_t num_ptrs = 10000;
+    size_t num_ptrs = benchmark_param_size(cfg, "ptrs", 10000);
+    if (num_ptrs < 2) num_ptrs = 2;
     void** ptrs = malloc(num_ptrs * sizeof(void*));
     if (!ptrs) return -1;
 
@@ -147,6 +273,12 @@ int bench_worst_case_fragmentation(allocator_api_t* api, benchmark_result_t* res
     double total_time_ns = 0;
     size_t total_requested = 0;
 
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
+    frag_tracker_t frag;
+    frag_tracker_init(&frag, result, num_ptrs * 2);
+
     for (size_t i = 0; i < num_ptrs; i++) {
         size_t size = (i % 2 == 0) ? small_size : large_size;
         total_requested += size;
@@ -155,22 +287,35 @@ int bench_worst_case_fragmentation(allocator_api_t* api, benchmark_result_t* res
         hr_timer_start(&timer);
         ptrs[i] = api->malloc(size);
         total_time_ns += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
+        if (ptrs[i]) frag_tracker_alloc(&frag, size);
     }
+    double frag_interleaved = frag_tracker_sample(&frag);
 
     for (size_t i = 0; i < num_ptrs; i += 2) {
+        if (!ptrs[i]) continue;
         hr_timer_init(&timer);
         hr_timer_start(&timer);
         api->free(ptrs[i]);
         total_time_ns += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
+        frag_tracker_free(&frag, small_size);
         ptrs[i] = NULL;
     }
+    double frag_holes = frag_tracker_sample(&frag);
 
     for (size_t i = 0; i < num_ptrs; i += 2) {
+        total_requested += large_size;
         hr_timer_init(&timer);
         hr_timer_start(&timer);
         ptrs[i] = api->malloc(large_size);
         total_time_ns += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
+        if (ptrs[i]) frag_tracker_alloc(&frag, large_size);
     }
+    double frag_large = frag_tracker_sample(&frag);
+
+    series_sampler_finish(&sampler);
 
     for (size_t i = 0; i < num_ptrs; i++) {
         if (ptrs[i]) {
@@ -180,7 +325,7 @@ int bench_worst_case_fragmentation(allocator_api_t* api, benchmark_result_t* res
 
     free(ptrs);
 
-    result->operations_count = num_ptrs * 3;
+    result->operations_count = num_ptrs * 2;
     result->thread_count = 1;
     result->total_ops_per_sec = (double)result->operations_count / (total_time_ns / 1e9);
     result->avg_alloc_time_ns = total_time_ns / result->operations_count;
@@ -190,72 +335,343 @@ int bench_worst_case_fragmentation(allocator_api_t* api, benchmark_result_t* res
     result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
     result->total_requested_bytes = total_requested;
     result->total_allocated_bytes = total_requested;
-    result->fragmentation_ratio = 1.5;
+    result->fragmentation_ratio = frag_large;
+
+    benchmark_result_add_metric(result, "frag_interleaved", frag_interleaved);
+    benchmark_result_add_metric(result, "frag_after_holes", frag_holes);
+    benchmark_result_add_metric(result, "frag_after_large", frag_large);
+    benchmark_result_add_metric(result, "frag_peak", frag.peak_ratio);
 
     return 0;
 }
 
+/* One Larson lane: a slot array that outlives the thread working on it. */
+typedef struct {
+    allocator_api_t* api;
+    void** ptrs;
+    size_t* sizes;
+    size_t array_size;
+    size_t operations;
+    const size_dist_t* dist;
+    unsigned int seed;
+    start_barrier_t* start_barrier;
+    double series_start_ns;
+    double sample_interval_ms;
+    double op_time_ns;
+    size_t alloc_count;
+    size_t free_count;
+    size_t requested;
+    size_t failures;
+    double start_ns;
+    double end_ns;
+    benchmark_series_t series;
+} larson_lane_t;
+
+static THREAD_FUNC larson_thread_func(THREAD_ARG arg) {
+    larson_lane_t* lane = (larson_lane_t*)arg;
+    allocator_api_t* api = lane->api;
+    hr_timer_t timer;
+
+    if (!start_barrier_wait(lane->start_barrier)) thread_return();
+    lane->start_ns = timer_now_ns();
+
+    /* Aligned to the start of the whole run so series from every round line up. */
+    series_sampler_t sampler;
+    series_sampler_init_at(&sampler, &lane->series, lane->sample_interval_ms, lane->series_start_ns);
+
+    for (size_t i = 0; i < lane->operations; i++) {
+        size_t index = xorshift32(&lane->seed) % lane->array_size;
+
+        if (lane->ptrs[index]) {
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            api->free(lane->ptrs[index]);
+            lane->op_time_ns += hr_timer_end(&timer);
+            series_sampler_add(&sampler, 1);
+            lane->ptrs[index] = NULL;
+            lane->sizes[index] = 0;
+            lane->free_count++;
+        }
+
+        size_t size = size_dist_sample(lane->dist, &lane->seed);
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        lane->ptrs[index] = api->malloc(size);
+        lane->op_time_ns += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
+
+        if (lane->ptrs[index]) {
+            memset(lane->ptrs[index], (int)i, size < 64 ? size : 64);
+            lane->sizes[index] = size;
+            lane->requested += size;
+            lane->alloc_count++;
+        } else {
+            lane->failures++;
+        }
+    }
+
+    lane->end_ns = timer_now_ns();
+    series_sampler_finish(&sampler);
+    thread_return();
+}
+
+/* Larson & Krishnan server simulation: each lane's objects survive the thread
+ * that allocated them, and a fresh thread inherits and frees them next round. */
 int bench_larson(allocator_api_t* api, benchmark_result_t* result, void* config) {
     benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
 
-    size_t iterations = cfg->iterations;
+    int thread_count = (int)benchmark_param_size(cfg, "threads", 4);
+    size_t rounds = benchmark_param_size(cfg, "rounds", 10);
+    size_t array_size = benchmark_param_size(cfg, "array_size", 1000);
+    if (thread_count < 1) thread_count = 1;
+    if (rounds < 1) rounds = 1;
+    if (array_size < 1) array_size = 1;
+
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
+
+    size_t ops_per_lane = cfg->iterations / ((size_t)thread_count * rounds);
+    if (ops_per_lane < 1) ops_per_lane = 1;
+
+    THREAD_TYPE* threads = malloc(thread_count * sizeof(THREAD_TYPE));
+    larson_lane_t* lanes = calloc(thread_count, sizeof(larson_lane_t));
+    size_t* round_rss_kb = calloc(rounds, sizeof(size_t));
+    if (!threads || !lanes || !round_rss_kb) {
+        free(threads);
+        free(lanes);
+        free(round_rss_kb);
+        return -1;
+    }
+
     unsigned int seed = cfg->seed;
-    size_t min_size = cfg->min_size;
-    size_t max_size = cfg->max_size;
+    int ok = 1;
+    for (int t = 0; t < thread_count; t++) {
+        larson_lane_t* lane = &lanes[t];
+        lane->api = api;
+        lane->ptrs = calloc(array_size, sizeof(void*));
+        lane->sizes = calloc(array_size, sizeof(size_t));
+        lane->array_size = array_size;
+        lane->operations = ops_per_lane;
+        lane->dist = &dist;
+        lane->seed = cfg->seed + t * 12345;
+        lane->sample_interval_ms = cfg->sample_interval_ms;
+        if (!lane->ptrs || !lane->sizes) {
+            ok = 0;
+            continue;
+        }
 
-    size_t array_size = 1000;
-    void** ptrs = calloc(array_size, sizeof(void*));
-    size_t* sizes = calloc(array_size, sizeof(size_t));
+        /* The main thread seeds every lane, so round one already frees remotely. */
+        for (size_t i = 0; i < array_size; i++) {
+            size_t size = size_dist_sample(&dist, &seed);
+            lane->ptrs[i] = api->malloc(size);
+            if (lane->ptrs[i]) lane->sizes[i] = size;
+        }
+    }
 
-    if (!ptrs || !sizes) {
-        free(ptrs);
-        free(sizes);
-        return -1;
+    double series_start_ns = timer_now_ns();
+    double run_time_ns = 0;
+    double op_time_ns = 0;
+    size_t alloc_count = 0, free_count = 0, requested = 0, failures = 0;
+
+    for (size_t round = 0; ok && round < rounds; round++) {
+        start_barrier_t start_barrier;
+        start_barrier_init(&start_barrier);
+
+        int started = 0;
+        for (; started < thread_count; started++) {
+            larson_lane_t* lane = &lanes[started];
+            lane->start_barrier = &start_barrier;
+            lane->series_start_ns = series_start_ns;
+            lane->op_time_ns = 0;
+            lane->alloc_count = 0;
+            lane->free_count = 0;
+            lane->requested = 0;
+            if (thread_create(&threads[started], larson_thread_func, lane) != 0) break;
+        }
+        if (started < thread_count) {
+            start_barrier_abort(&start_barrier);
+            for (int t = 0; t < started; t++) thread_join(threads[t]);
+            start_barrier_destroy(&start_barrier);
+            ok = 0;
+            break;
+        }
+
+        start_barrier_release(&start_barrier, started);
+
+        for (int t = 0; t < thread_count; t++) {
+            thread_join(threads[t]);
+        }
+        start_barrier_destroy(&start_barrier);
+
+        double first_start_ns = lanes[0].start_ns;
+        double last_end_ns = lanes[0].end_ns;
+        for (int t = 0; t < thread_count; t++) {
+            if (lanes[t].start_ns < first_start_ns) first_start_ns = lanes[t].start_ns;
+            if (lanes[t].end_ns > last_end_ns) last_end_ns = lanes[t].end_ns;
+            op_time_ns += lanes[t].op_time_ns;
+            alloc_count += lanes[t].alloc_count;
+            free_count += lanes[t].free_count;
+            requested += lanes[t].requested;
+            series_merge(&result->throughput_series, &lanes[t].series);
+        }
+        run_time_ns += last_end_ns - first_start_ns;
+
+        /* Threads from this round have exited; whatever they cached is now orphaned. */
+        round_rss_kb[round] = memory_stats_sample();
+    }
+
+    for (int t = 0; t < thread_count; t++) failures += lanes[t].failures;
+
+    size_t live_bytes = 0;
+    for (int t = 0; t < thread_count; t++) {
+        larson_lane_t* lane = &lanes[t];
+        for (size_t i = 0; lane->ptrs && i < array_size; i++) {
+            if (lane->ptrs[i]) {
+                live_bytes += lane->sizes[i];
+                api->free(lane->ptrs[i]);
+            }
+        }
+        free(lane->ptrs);
+        free(lane->sizes);
+    }
+
+    /* Steady state: mean RSS over the second half of the rounds. */
+    size_t steady_from = rounds / 2;
+    double steady_rss_kb = 0;
+    for (size_t r = steady_from; r < rounds; r++) steady_rss_kb += (double)round_rss_kb[r];
+    steady_rss_kb /= (double)(rounds - steady_from);
+
+    free(threads);
+    free(lanes);
+    free(round_rss_kb);
+
+    if (!ok || failures > 0) return -1;
+
+    result->operations_count = alloc_count + free_count;
+    result->thread_count = thread_count;
+    result->alloc_ops_per_sec = (double)alloc_count / (run_time_ns / 1e9);
+    result->free_ops_per_sec = (double)free_count / (run_time_ns / 1e9);
+    result->total_ops_per_sec = (double)result->operations_count / (run_time_ns / 1e9);
+    result->avg_alloc_time_ns = op_time_ns / result->operations_count;
+    result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->total_requested_bytes = requested;
+    result->total_allocated_bytes = requested;
+    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+    benchmark_result_add_metric(result, "rounds", (double)rounds);
+    benchmark_result_add_metric(result, "array_size", (double)array_size);
+    benchmark_result_add_metric(result, "steady_rss_kb", steady_rss_kb);
+    benchmark_result_add_metric(result, "steady_live_kb", (double)live_bytes / 1024.0);
+    benchmark_result_add_metric(result, "steady_rss_per_live",
+                                live_bytes > 0 ? steady_rss_kb * 1024.0 / (double)live_bytes
+                                               : BENCHMARK_METRIC_NA);
+
+    return 0;
+}
+
+#define LIFETIME_RSS_SAMPLES 128
+
+static int run_lifetime(allocator_api_t* api, benchmark_result_t* result,
+                        benchmark_config_t* cfg, lifetime_kind_t kind) {
+    size_t iterations = cfg->iterations;
+    unsigned int seed = cfg->seed;
+
+    lifetime_model_t model;
+    double mean = benchmark_param_double(cfg, "lifetime", 1000);
+    if (kind == LIFETIME_FIXED) {
+        lifetime_model_fixed(&model, (uint64_t)mean);
+    } else if (kind == LIFETIME_EXPONENTIAL) {
+        lifetime_model_exponential(&model, mean);
+    } else {
+        lifetime_model_generational(&model,
+                                    benchmark_param_double(cfg, "young_fraction", 0.95),
+                                    benchmark_param_double(cfg, "young_mean", 64),
+                                    benchmark_param_double(cfg, "old_mean", 65536));
     }
 
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
+
+    expiry_queue_t queue;
+    if (expiry_queue_init(&queue, 1024) != 0) return -1;
+
     hr_timer_t timer;
     double total_time_ns = 0;
     size_t total_requested = 0;
+    size_t live_bytes = 0;
     size_t alloc_count = 0;
     size_t free_count = 0;
-
-    for (size_t i = 0; i < iterations; i++) {
-        size_t index = xorshift32(&seed) % array_size;
-
-        if (ptrs[index]) {
+    int ok = 1;
+
+    /* RSS / live bytes is only sampled in the second half, once the live set
+     * has had time to reach its steady size. */
+    size_t sample_every = iterations / LIFETIME_RSS_SAMPLES;
+    if (sample_every < 1) sample_every = 1;
+    double ratio_sum = 0;
+    double rss_sum_kb = 0;
+    double live_sum = 0;
+    int ratio_samples = 0;
+
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
+    for (uint64_t clock = 0; clock < iterations; clock++) {
+        expiry_entry_t expired;
+        while (expiry_queue_pop_expired(&queue, clock, &expired)) {
             hr_timer_init(&timer);
             hr_timer_start(&timer);
-            api->free(ptrs[index]);
+            api->free(expired.ptr);
             total_time_ns += hr_timer_end(&timer);
-            ptrs[index] = NULL;
-            sizes[index] = 0;
+            series_sampler_add(&sampler, 1);
+            live_bytes -= expired.size;
             free_count++;
         }
 
-        size_t size = min_size + xorshift32(&seed) % (max_size - min_size + 1);
-        total_requested += size;
+        size_t size = size_dist_sample(&dist, &seed);
 
         hr_timer_init(&timer);
         hr_timer_start(&timer);
-        ptrs[index] = api->malloc(size);
+        void* ptr = api->malloc(size);
         total_time_ns += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 1);
 
-        if (ptrs[index]) {
-            sizes[index] = size;
-            alloc_count++;
+        if (!ptr) {
+            ok = 0;
+            break;
         }
-    }
+        memset(ptr, (int)clock, size < 64 ? size : 64);
+        alloc_count++;
+        total_requested += size;
+        live_bytes += size;
 
-    size_t active_memory = 0;
-    for (size_t i = 0; i < array_size; i++) {
-        if (ptrs[i]) {
-            active_memory += sizes[i];
-            api->free(ptrs[i]);
+        if (expiry_queue_push(&queue, clock + lifetime_model_sample(&model, &seed), ptr, size) != 0) {
+            api->free(ptr);
+            ok = 0;
+            break;
+        }
+
+        if (clock >= iterations / 2 && clock % sample_every == 0 && live_bytes > 0) {
+            size_t rss_kb = memory_stats_sample();
+            ratio_sum += (double)rss_kb * 1024.0 / (double)live_bytes;
+            rss_sum_kb += (double)rss_kb;
+            live_sum += (double)live_bytes;
+            ratio_samples++;
         }
     }
 
-    free(ptrs);
-    free(sizes);
+    series_sampler_finish(&sampler);
+
+    size_t remaining = queue.count;
+    for (size_t i = 0; i < queue.count; i++) {
+        api->free(queue.entries[i].ptr);
+    }
+    expiry_queue_destroy(&queue);
+
+    if (!ok) return -1;
 
     result->operations_count = alloc_count + free_count;
     result->thread_count = 1;
@@ -269,7 +685,295 @@ int bench_larson(allocator_api_t* api, benchmark_result_t* result, void* config)
     result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
     result->total_requested_bytes = total_requested;
     result->total_allocated_bytes = total_requested;
-    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+    result->fragmentation_ratio = ratio_samples ? ratio_sum / ratio_samples : BENCHMARK_METRIC_NA;
+
+    benchmark_result_add_metric(result, "mean_lifetime", lifetime_model_mean(&model));
+    benchmark_result_add_metric(result, "steady_rss_kb", ratio_samples ? rss_sum_kb / ratio_samples : BENCHMARK_METRIC_NA);
+    benchmark_result_add_metric(result, "steady_live_kb", ratio_samples ? live_sum / ratio_samples / 1024.0 : BENCHMARK_METRIC_NA);
+    benchmark_result_add_metric(result, "steady_rss_per_live", result->fragmentation_ratio);
+    benchmark_result_add_metric(result, "live_at_end", (double)remaining);
+
+    return 0;
+}
+
+int bench_lifetime_fixed(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+    return run_lifetime(api, result, cfg, LIFETIME_FIXED);
+}
+
+int bench_lifetime_exponential(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+    return run_lifetime(api, result, cfg, LIFETIME_EXPONENTIAL);
+}
+
+int bench_lifetime_generational(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+    return run_lifetime(api, result, cfg, LIFETIME_GENERATIONAL);
+}
+
+typedef struct {
+    void* ptr;
+    size_t size;
+} frag_object_t;
+
+typedef struct {
+    frag_object_t* items;
+    size_t count;
+    size_t capacity;
+} frag_object_list_t;
+
+/* Shared state for the phase-driven scenarios: every allocator call goes
+ * through frag_run_alloc/free so timing, throughput and RSS / live stay in step. */
+typedef struct {
+    allocator_api_t* api;
+    frag_tracker_t frag;
+    series_sampler_t sampler;
+    double time_ns;
+    size_t alloc_count;
+    size_t free_count;
+    size_t requested;
+    unsigned int seed;
+} frag_run_t;
+
+static int object_list_push(frag_object_list_t* list, void* ptr, size_t size) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 1024;
+        frag_object_t* items = realloc(list->items, capacity * sizeof(frag_object_t));
+        if (!items) return -1;
+        list->items = items;
+        list->capacity = capacity;
+    }
+    list->items[list->count].ptr = ptr;
+    list->items[list->count].size = size;
+    list->count++;
+    return 0;
+}
+
+static void frag_run_init(frag_run_t* run, allocator_api_t* api, benchmark_result_t* result,
+                          benchmark_config_t* cfg, size_t expected_ops) {
+    memset(run, 0, sizeof(frag_run_t));
+    run->api = api;
+    run->seed = cfg->seed;
+    frag_tracker_init(&run->frag, result, expected_ops);
+    series_sampler_init(&run->sampler, &result->throughput_series, cfg->sample_interval_ms);
+}
+
+static int frag_run_alloc(frag_run_t* run, frag_object_list_t* list, size_t size) {
+    hr_timer_t timer;
+    hr_timer_init(&timer);
+    hr_timer_start(&timer);
+    void* ptr = run->api->malloc(size);
+    run->time_ns += hr_timer_end(&timer);
+    series_sampler_add(&run->sampler, 1);
+
+    if (!ptr) return -1;
+    /* Touch everything so resident memory reflects the live bytes. */
+    memset(ptr, 0xA5, size);
+    if (object_list_push(list, ptr, size) != 0) {
+        run->api->free(ptr);
+        return -1;
+    }
+    run->alloc_count++;
+    run->requested += size;
+    frag_tracker_alloc(&run->frag, size);
+    return 0;
+}
+
+static void frag_run_free(frag_run_t* run, frag_object_t* object) {
+    hr_timer_t timer;
+    hr_timer_init(&timer);
+    hr_timer_start(&timer);
+    run->api->free(object->ptr);
+    run->time_ns += hr_timer_end(&timer);
+    series_sampler_add(&run->sampler, 1);
+
+    run->free_count++;
+    frag_tracker_free(&run->frag, object->size);
+    object->ptr = NULL;
+}
+
+static void frag_run_free_all(frag_run_t* run, frag_object_list_t* list) {
+    for (size_t i = 0; i < list->count; i++) frag_run_free(run, &list->items[i]);
+    list->count = 0;
+}
+
+static void frag_run_finish(frag_run_t* run, benchmark_result_t* result) {
+    series_sampler_finish(&run->sampler);
+
+    result->operations_count = run->alloc_count + run->free_count;
+    result->thread_count = 1;
+    result->alloc_ops_per_sec = BENCHMARK_METRIC_NA;
+    result->free_ops_per_sec = BENCHMARK_METRIC_NA;
+    result->total_ops_per_sec = (double)result->operations_count / (run->time_ns / 1e9);
+    result->avg_alloc_time_ns = run->time_ns / result->operations_count;
+    result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->total_requested_bytes = run->requested;
+    result->total_allocated_bytes = run->requested;
+}
+
+int bench_frag_interleaved(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+
+    size_t target = benchmark_param_size(cfg, "live_mb", 64) * 1024 * 1024;
+    size_t small_min = benchmark_param_size(cfg, "small_min", 16);
+    size_t small_max = benchmark_param_size(cfg, "small_max", 256);
+    size_t large_min = benchmark_param_size(cfg, "large_min", 4096);
+    size_t large_max = benchmark_param_size(cfg, "large_max", 65536);
+    size_t smalls_per_large = benchmark_param_size(cfg, "smalls_per_large", 4);
+    size_t rounds = benchmark_param_size(cfg, "rounds", 4);
+    if (small_min < 1) small_min = 1;
+    if (large_min < 1) large_min = 1;
+
+    /* --size-dist, when given, replaces the small size class. */
+    size_dist_t small_dist, large_dist;
+    if (size_dist_init(&small_dist, cfg->size_dist, small_min, small_max) != 0) return -1;
+    size_dist_uniform(&large_dist, large_min, large_max);
+
+    double small_avg = small_dist.mean_size;
+    double large_avg = large_dist.mean_size;
+    size_t expected = (size_t)(target / large_avg * (1 + smalls_per_large) +
+                               rounds * 2 * (target / small_avg + target / large_avg));
+
+    frag_run_t run;
+    frag_run_init(&run, api, result, cfg, expected);
+    frag_object_list_t smalls = {0}, refill = {0}, larges = {0};
+    int ok = 1;
+
+    /* Pinned small objects sit between the large ones, so freeing the large
+     * objects leaves holes an allocator can only hand back page by page. */
+    while (ok && run.frag.live_bytes < target) {
+        if (frag_run_alloc(&run, &larges, size_dist_sample(&large_dist, &run.seed)) != 0) ok = 0;
+        for (size_t s = 0; ok && s < smalls_per_large; s++) {
+            if (frag_run_alloc(&run, &smalls, size_dist_sample(&small_dist, &run.seed)) != 0) ok = 0;
+        }
+    }
+    double frag_filled = frag_tracker_sample(&run.frag);
+
+    double freed_sum = 0, small_sum = 0, large_sum = 0;
+    int freed_count = 0, small_count = 0, large_count = 0;
+    double frag_final = BENCHMARK_METRIC_NA;
+
+    for (size_t round = 0; ok && round < rounds; round++) {
+        frag_run_free_all(&run, &larges);
+        double ratio = frag_tracker_sample(&run.frag);
+        if (ratio != BENCHMARK_METRIC_NA) { freed_sum += ratio; freed_count++; }
+
+        while (ok && run.frag.live_bytes < target) {
+            if (frag_run_alloc(&run, &refill, size_dist_sample(&small_dist, &run.seed)) != 0) ok = 0;
+        }
+        ratio = frag_tracker_sample(&run.frag);
+        if (ratio != BENCHMARK_METRIC_NA) { small_sum += ratio; small_count++; }
+
+        frag_run_free_all(&run, &refill);
+        while (ok && run.frag.live_bytes < target) {
+            if (frag_run_alloc(&run, &larges, size_dist_sample(&large_dist, &run.seed)) != 0) ok = 0;
+        }
+        frag_final = frag_tracker_sample(&run.frag);
+        if (frag_final != BENCHMARK_METRIC_NA) { large_sum += frag_final; large_count++; }
+    }
+
+    size_t small_objects = smalls.count;
+    frag_run_free_all(&run, &larges);
+    frag_run_free_all(&run, &refill);
+    frag_run_free_all(&run, &smalls);
+    free(larges.items);
+    free(refill.items);
+    free(smalls.items);
+
+    if (!ok) return -1;
+
+    frag_run_finish(&run, result);
+    result->fragmentation_ratio = mean_or_na(small_sum + large_sum, small_count + large_count);
+
+    benchmark_result_add_metric(result, "live_target_kb", (double)target / 1024.0);
+    benchmark_result_add_metric(result, "pinned_small_objects", (double)small_objects);
+    benchmark_result_add_metric(result, "frag_filled", frag_filled);
+    benchmark_result_add_metric(result, "frag_large_freed", mean_or_na(freed_sum, freed_count));
+    benchmark_result_add_metric(result, "frag_small_refill", mean_or_na(small_sum, small_count));
+    benchmark_result_add_metric(result, "frag_large_refill", mean_or_na(large_sum, large_count));
+    benchmark_result_add_metric(result, "frag_final", frag_final);
+    benchmark_result_add_metric(result, "frag_peak", run.frag.peak_ratio);
+
+    return 0;
+}
+
+int bench_frag_swiss_cheese(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+
+    size_t target = benchmark_param_size(cfg, "live_mb", 64) * 1024 * 1024;
+    size_t obj_min = benchmark_param_size(cfg, "obj_min", 64);
+    size_t obj_max = benchmark_param_size(cfg, "obj_max", 1024);
+    size_t large_min = benchmark_param_size(cfg, "large_min", 8192);
+    size_t large_max = benchmark_param_size(cfg, "large_max", 65536);
+    double hole_fraction = benchmark_param_double(cfg, "hole_fraction", 0.5);
+    size_t rounds = benchmark_param_size(cfg, "rounds", 3);
+    if (obj_min < 1) obj_min = 1;
+    if (large_min < 1) large_min = 1;
+    if (hole_fraction < 0.0) hole_fraction = 0.0;
+    if (hole_fraction > 1.0) hole_fraction = 1.0;
+
+    /* --size-dist, when given, replaces the fill object sizes. */
+    size_dist_t obj_dist, large_dist;
+    if (size_dist_init(&obj_dist, cfg->size_dist, obj_min, obj_max) != 0) return -1;
+    size_dist_uniform(&large_dist, large_min, large_max);
+
+    size_t fill_objects = (size_t)(target / obj_dist.mean_size);
+    size_t expected = fill_objects + rounds * (size_t)(fill_objects * hole_fraction * 1.5);
+
+    frag_run_t run;
+    frag_run_init(&run, api, result, cfg, expected);
+    frag_object_list_t objects = {0};
+    int ok = 1;
+
+    while (ok && run.frag.live_bytes < target) {
+        if (frag_run_alloc(&run, &objects, size_dist_sample(&obj_dist, &run.seed)) != 0) ok = 0;
+    }
+    double frag_filled = frag_tracker_sample(&run.frag);
+
+    unsigned int hole_threshold = (unsigned int)(hole_fraction * 65536.0);
+    double holes_sum = 0, large_sum = 0;
+    int holes_count = 0, large_count = 0;
+    double frag_final = BENCHMARK_METRIC_NA;
+
+    /* Later rounds punch holes in the large blocks too, so the heap gets
+     * progressively more mixed. */
+    for (size_t round = 0; ok && round < rounds; round++) {
+        size_t kept = 0;
+        for (size_t i = 0; i < objects.count; i++) {
+            if ((xorshift32(&run.seed) & 0xFFFF) < hole_threshold) {
+                frag_run_free(&run, &objects.items[i]);
+            } else {
+                objects.items[kept++] = objects.items[i];
+            }
+        }
+        objects.count = kept;
+        double ratio = frag_tracker_sample(&run.frag);
+        if (ratio != BENCHMARK_METRIC_NA) { holes_sum += ratio; holes_count++; }
+
+        while (ok && run.frag.live_bytes < target) {
+            if (frag_run_alloc(&run, &objects, size_dist_sample(&large_dist, &run.seed)) != 0) ok = 0;
+        }
+        frag_final = frag_tracker_sample(&run.frag);
+        if (frag_final != BENCHMARK_METRIC_NA) { large_sum += frag_final; large_count++; }
+    }
+
+    frag_run_free_all(&run, &objects);
+    free(objects.items);
+
+    if (!ok) return -1;
+
+    frag_run_finish(&run, result);
+    result->fragmentation_ratio = mean_or_na(large_sum, large_count);
+
+    benchmark_result_add_metric(result, "live_target_kb", (double)target / 1024.0);
+    benchmark_result_add_metric(result, "frag_filled", frag_filled);
+    benchmark_result_add_metric(result, "frag_holes", mean_or_na(holes_sum, holes_count));
+    benchmark_result_add_metric(result, "frag_after_large", mean_or_na(large_sum, large_count));
+    benchmark_result_add_metric(result, "frag_final", frag_final);
+    benchmark_result_add_metric(result, "frag_peak", run.frag.peak_ratio);
 
     return 0;
 }
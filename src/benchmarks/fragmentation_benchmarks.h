@@ -8,5 +8,10 @@ void register_fragmentation_benchmarks(void);
 int bench_fragmentation_pattern(allocator_api_t* api, benchmark_result_t* result, void* config);
 int bench_worst_case_fragmentation(allocator_api_t* api, benchmark_result_t* result, void* config);
 int bench_larson(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_lifetime_fixed(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_lifetime_exponential(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_lifetime_generational(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_frag_interleaved(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_frag_swiss_cheese(allocator_api_t* api, benchmark_result_t* result, void* config);
 
 #endif
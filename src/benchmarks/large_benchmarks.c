@@ -0,0 +1,717 @@
+#include "large_benchmarks.h"
+#include "timer.h"
+#include "memory_stats.h"
+#include "latency.h"
+#include "syscall_stats.h"
+#include "size_dist.h"
+#include "perf_counters.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#define LARGE_LATENCY_SAMPLES 16384
+#define LARGE_MAX_SLOTS 64
+
+/* The harness-wide iteration count is far too many for gigabyte blocks, so
+ * these benchmarks take their operation counts from parameters instead. */
+static benchmark_config_t large_config = {
+    .iterations = 1000000,
+    .min_size = 64 * 1024,
+    .max_size = 1024UL * 1024 * 1024,
+    .thread_count = 1,
+    .seed = 42,
+    .sample_interval_ms = 0,
+    .params = NULL,
+    .size_dist = NULL
+};
+
+/* Working-set blocks from a page up to two huge pages, so the allocator's
+ * own heap and its direct mappings both get exercised. */
+static benchmark_config_t thp_config = {
+    .iterations = 1000000,
+    .min_size = 4096,
+    .max_size = 4 * 1024 * 1024,
+    .thread_count = 1,
+    .seed = 42,
+    .sample_interval_ms = 0,
+    .params = NULL,
+    .size_dist = NULL
+};
+
+typedef enum {
+    LARGE_CHURN,
+    LARGE_TOUCH,
+    LARGE_REALLOC
+} large_workload_t;
+
+typedef struct {
+    latency_recorder_t alloc_lat;
+    latency_recorder_t free_lat;
+    double touch_ns;
+    size_t touched_bytes;
+    size_t alloc_count;
+    size_t free_count;
+    size_t realloc_count;
+    size_t moved_count;
+    size_t moved_bytes;
+    size_t requested_bytes;
+    size_t peak_rss_kb;
+    syscall_stats_t syscalls;
+} large_run_t;
+
+static unsigned int xorshift32(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+void register_large_benchmarks(void) {
+    static benchmark_t bench1 = {
+        .name = "large_churn",
+        .description = "64 KB-1 GB alloc/free churn over a few live slots",
+        .run = bench_large_churn,
+        .default_config = &large_config
+    };
+    benchmark_register(&bench1);
+
+    static benchmark_t bench2 = {
+        .name = "large_touch",
+        .description = "64 KB-1 GB allocate, write every byte, free",
+        .run = bench_large_touch,
+        .default_config = &large_config
+    };
+    benchmark_register(&bench2);
+
+    static benchmark_t bench3 = {
+        .name = "large_realloc",
+        .description = "Realloc growth from 64 KB to 1 GB, touching each new tail",
+        .run = bench_large_realloc,
+        .default_config = &large_config
+    };
+    benchmark_register(&bench3);
+
+    static benchmark_t bench4 = {
+        .name = "thp_working_set",
+        .description = "Random access over a large heap under sysfs THP, prctl disable, MADV_HUGEPAGE, MADV_NOHUGEPAGE",
+        .run = bench_thp_working_set,
+        .default_config = &thp_config
+    };
+    benchmark_register(&bench4);
+}
+
+static void large_dist_init(size_dist_t* dist, benchmark_config_t* cfg) {
+    if (cfg->size_dist) {
+        size_dist_init(dist, cfg->size_dist, cfg->min_size, cfg->max_size);
+        return;
+    }
+
+    /* Log-uniform, so every power of two in the range gets equal weight
+     * instead of the top octave taking half the draws. */
+    char spec[SIZE_DIST_MAX_SPEC];
+    snprintf(spec, sizeof(spec), "loguniform:%zu-%zu", cfg->min_size, cfg->max_size);
+    size_dist_init(dist, spec, cfg->min_size, cfg->max_size);
+}
+
+/* RSS is read directly rather than through memory_stats_sample so that the
+ * reference run does not leak into the harness's peak for the allocator. */
+static void track_rss(large_run_t* run, size_t baseline_kb, int record_peak) {
+    size_t rss = record_peak ? memory_stats_sample() : get_current_rss_kb();
+    if (!record_peak) rss = rss > baseline_kb ? rss - baseline_kb : 0;
+    if (rss > run->peak_rss_kb) run->peak_rss_kb = rss;
+}
+
+static int run_churn(allocator_api_t* api, benchmark_config_t* cfg, large_run_t* run, int record_peak) {
+    size_t ops = benchmark_param_size(cfg, "ops", 4096);
+    size_t slot_count = benchmark_param_size(cfg, "slots", 8);
+    if (slot_count < 1) slot_count = 1;
+    if (slot_count > LARGE_MAX_SLOTS) slot_count = LARGE_MAX_SLOTS;
+
+    size_dist_t dist;
+    large_dist_init(&dist, cfg);
+
+    void* slots[LARGE_MAX_SLOTS] = {0};
+    unsigned int seed = cfg->seed;
+    size_t baseline_kb = get_current_rss_kb();
+    hr_timer_t timer;
+    int ok = 1;
+
+    for (size_t i = 0; i < ops; i++) {
+        size_t slot = size_dist_next(&seed) % slot_count;
+
+        if (slots[slot]) {
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            api->free(slots[slot]);
+            latency_recorder_add(&run->free_lat, hr_timer_end(&timer));
+            slots[slot] = NULL;
+            run->free_count++;
+        }
+
+        size_t size = size_dist_sample(&dist, &seed);
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        slots[slot] = api->malloc(size);
+        latency_recorder_add(&run->alloc_lat, hr_timer_end(&timer));
+
+        if (!slots[slot]) {
+            ok = 0;
+            break;
+        }
+        /* One byte, so the block is real but its pages mostly stay untouched. */
+        *(volatile char*)slots[slot] = (char)i;
+        run->alloc_count++;
+        run->requested_bytes += size;
+
+        track_rss(run, baseline_kb, record_peak);
+    }
+
+    for (size_t s = 0; s < slot_count; s++) {
+        if (!slots[s]) continue;
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        api->free(slots[s]);
+        latency_recorder_add(&run->free_lat, hr_timer_end(&timer));
+        run->free_count++;
+    }
+
+    return ok ? 0 : -1;
+}
+
+static int run_touch(allocator_api_t* api, benchmark_config_t* cfg, large_run_t* run, int record_peak) {
+    size_t ops = benchmark_param_size(cfg, "ops", 48);
+
+    size_dist_t dist;
+    large_dist_init(&dist, cfg);
+
+    unsigned int seed = cfg->seed;
+    size_t baseline_kb = get_current_rss_kb();
+    hr_timer_t timer;
+
+    for (size_t i = 0; i < ops; i++) {
+        size_t size = size_dist_sample(&dist, &seed);
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        char* ptr = api->malloc(size);
+        latency_recorder_add(&run->alloc_lat, hr_timer_end(&timer));
+        if (!ptr) return -1;
+        run->alloc_count++;
+        run->requested_bytes += size;
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        memset(ptr, (int)(i & 0xff) | 1, size);
+        run->touch_ns += hr_timer_end(&timer);
+        run->touched_bytes += size;
+
+        track_rss(run, baseline_kb, record_peak);
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        api->free(ptr);
+        latency_recorder_add(&run->free_lat, hr_timer_end(&timer));
+        run->free_count++;
+    }
+
+    return 0;
+}
+
+static int run_realloc(allocator_api_t* api, benchmark_config_t* cfg, large_run_t* run, int record_peak) {
+    size_t rounds = benchmark_param_size(cfg, "rounds", 4);
+    double growth = benchmark_param_double(cfg, "growth", 2.0);
+    if (growth < 1.01) growth = 1.01;
+
+    size_t baseline_kb = get_current_rss_kb();
+    hr_timer_t timer;
+
+    for (size_t r = 0; r < rounds; r++) {
+        size_t size = cfg->min_size;
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        char* ptr = api->malloc(size);
+        latency_recorder_add(&run->alloc_lat, hr_timer_end(&timer));
+        if (!ptr) return -1;
+        memset(ptr, (int)r | 1, size);
+        run->alloc_count++;
+        run->requested_bytes += size;
+
+        while (size < cfg->max_size) {
+            size_t new_size = (size_t)((double)size * growth);
+            if (new_size > cfg->max_size) new_size = cfg->max_size;
+
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            char* grown = api->realloc(ptr, new_size);
+            latency_recorder_add(&run->alloc_lat, hr_timer_end(&timer));
+            if (!grown) {
+                api->free(ptr);
+                return -1;
+            }
+
+            if (grown != ptr) {
+                run->moved_count++;
+                run->moved_bytes += size;
+            }
+            run->realloc_count++;
+            run->requested_bytes += new_size - size;
+
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            memset(grown + size, (int)r | 1, new_size - size);
+            run->touch_ns += hr_timer_end(&timer);
+            run->touched_bytes += new_size - size;
+
+            ptr = grown;
+            size = new_size;
+            track_rss(run, baseline_kb, record_peak);
+        }
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        api->free(ptr);
+        latency_recorder_add(&run->free_lat, hr_timer_end(&timer));
+        run->free_count++;
+    }
+
+    return 0;
+}
+
+static int large_run(allocator_api_t* api, benchmark_config_t* cfg, large_workload_t workload,
+                     large_run_t* run, int record_peak) {
+    memset(run, 0, sizeof(large_run_t));
+    if (latency_recorder_init(&run->alloc_lat, LARGE_LATENCY_SAMPLES) != 0) return -1;
+    if (latency_recorder_init(&run->free_lat, LARGE_LATENCY_SAMPLES) != 0) {
+        latency_recorder_destroy(&run->alloc_lat);
+        return -1;
+    }
+
+    syscall_stats_t before, after;
+    syscall_stats_get(&before);
+
+    int ret;
+    switch (workload) {
+        case LARGE_CHURN: ret = run_churn(api, cfg, run, record_peak); break;
+        case LARGE_TOUCH: ret = run_touch(api, cfg, run, record_peak); break;
+        default: ret = run_realloc(api, cfg, run, record_peak); break;
+    }
+
+    syscall_stats_get(&after);
+    syscall_stats_diff(&run->syscalls, &before, &after);
+    return ret;
+}
+
+static void large_run_destroy(large_run_t* run) {
+    latency_recorder_destroy(&run->alloc_lat);
+    latency_recorder_destroy(&run->free_lat);
+}
+
+static int bench_large(allocator_api_t* api, benchmark_result_t* result,
+                       benchmark_config_t* cfg, large_workload_t workload) {
+    large_run_t run;
+    if (large_run(api, cfg, workload, &run, 1) != 0) {
+        large_run_destroy(&run);
+        return -1;
+    }
+
+    double alloc_ns = run.alloc_lat.total;
+    double free_ns = run.free_lat.total;
+    double total_ns = alloc_ns + free_ns + run.touch_ns;
+
+    result->operations_count = run.alloc_count + run.realloc_count + run.free_count;
+    result->thread_count = 1;
+    result->alloc_ops_per_sec = (run.alloc_count + run.realloc_count) / (alloc_ns / 1e9);
+    result->free_ops_per_sec = run.free_count / (free_ns / 1e9);
+    if (workload == LARGE_REALLOC) result->realloc_ops_per_sec = result->alloc_ops_per_sec;
+    result->total_ops_per_sec = result->operations_count / (total_ns / 1e9);
+    result->avg_alloc_time_ns = latency_recorder_mean(&run.alloc_lat);
+    result->min_alloc_time_ns = run.alloc_lat.min;
+    result->max_alloc_time_ns = run.alloc_lat.max;
+    result->p50_alloc_time_ns = latency_recorder_percentile(&run.alloc_lat, 0.50);
+    result->p99_alloc_time_ns = latency_recorder_percentile(&run.alloc_lat, 0.99);
+    result->total_requested_bytes = run.requested_bytes;
+    result->total_allocated_bytes = run.requested_bytes;
+    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+    benchmark_result_add_metric(result, "avg_free_ns", latency_recorder_mean(&run.free_lat));
+    benchmark_result_add_metric(result, "p99_free_ns", latency_recorder_percentile(&run.free_lat, 0.99));
+    if (run.touched_bytes > 0) {
+        benchmark_result_add_metric(result, "touch_gb_per_sec",
+                                    run.touched_bytes / run.touch_ns);
+    }
+    if (workload == LARGE_REALLOC) {
+        benchmark_result_add_metric(result, "moved_fraction",
+                                    run.realloc_count ? (double)run.moved_count / run.realloc_count : 0.0);
+        benchmark_result_add_metric(result, "moved_mb", run.moved_bytes / (1024.0 * 1024.0));
+    }
+
+    /* The C library's malloc maps memory through internal entry points the
+     * link-time wrappers cannot see, so its counts would read as zero. */
+    int counted = syscall_stats_available() && strcmp(api->name, "system") != 0;
+    benchmark_result_add_metric(result, "mmap_calls", counted ? (double)run.syscalls.mmap_calls : BENCHMARK_METRIC_NA);
+    benchmark_result_add_metric(result, "munmap_calls", counted ? (double)run.syscalls.munmap_calls : BENCHMARK_METRIC_NA);
+    benchmark_result_add_metric(result, "mremap_calls", counted ? (double)run.syscalls.mremap_calls : BENCHMARK_METRIC_NA);
+    benchmark_result_add_metric(result, "mmap_mb", counted ? run.syscalls.mmap_bytes / (1024.0 * 1024.0) : BENCHMARK_METRIC_NA);
+    benchmark_result_add_metric(result, "rss_peak_kb", (double)run.peak_rss_kb);
+
+    /* Same workload and seed against one mmap per block. */
+    allocator_api_t reference;
+    mmap_allocator_init(&reference);
+    large_run_t ref;
+    memset(&ref, 0, sizeof(ref));
+    if (reference.malloc && large_run(&reference, cfg, workload, &ref, 0) == 0) {
+        double ref_alloc = latency_recorder_mean(&ref.alloc_lat);
+        benchmark_result_add_metric(result, "ref_avg_alloc_ns", ref_alloc);
+        benchmark_result_add_metric(result, "ref_p99_alloc_ns", latency_recorder_percentile(&ref.alloc_lat, 0.99));
+        benchmark_result_add_metric(result, "ref_avg_free_ns", latency_recorder_mean(&ref.free_lat));
+        benchmark_result_add_metric(result, "ref_rss_peak_kb", (double)ref.peak_rss_kb);
+        if (ref.touched_bytes > 0) {
+            benchmark_result_add_metric(result, "ref_touch_gb_per_sec", ref.touched_bytes / ref.touch_ns);
+        }
+        benchmark_result_add_metric(result, "alloc_vs_mmap", result->avg_alloc_time_ns / ref_alloc);
+    }
+    large_run_destroy(&ref);
+    large_run_destroy(&run);
+
+    return 0;
+}
+
+int bench_large_churn(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &large_config;
+    return bench_large(api, result, cfg, LARGE_CHURN);
+}
+
+int bench_large_touch(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &large_config;
+    return bench_large(api, result, cfg, LARGE_TOUCH);
+}
+
+int bench_large_realloc(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &large_config;
+    return bench_large(api, result, cfg, LARGE_REALLOC);
+}
+
+typedef enum {
+    THP_MODE_SYSFS,
+    THP_MODE_PRCTL_DISABLE,
+    THP_MODE_MADV_HUGEPAGE,
+    THP_MODE_MADV_NOHUGEPAGE
+} thp_mode_t;
+
+static const char* thp_mode_labels[] = {"sys", "prctl_off", "madv_huge", "madv_nohuge"};
+
+typedef struct {
+    int ok;
+    size_t allocs;
+    size_t frees;
+    size_t requested;
+    double alloc_ns;
+    double populate_ns;
+    double access_ns;
+    size_t accesses;
+    size_t rss_kb;
+    size_t anon_huge_kb;
+    double thp_faults;
+    double dtlb_loads;
+    double dtlb_misses;
+} thp_mode_result_t;
+
+typedef struct {
+    char* ptr;
+    size_t size;
+} thp_block_t;
+
+/* Blocks hold at least one word so the access loop always has a target. */
+static size_t thp_block_size(const size_dist_t* dist, unsigned int* seed) {
+    size_t size = size_dist_sample(dist, seed);
+    return size < sizeof(uint64_t) ? sizeof(uint64_t) : size;
+}
+
+/* Position of the bracketed choice in the sysfs setting: 0 always,
+ * 1 madvise, 2 never; -1 if the file is missing. */
+static int thp_sysfs_mode(void) {
+    FILE* fp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    if (!fp) return -1;
+
+    char line[128];
+    int mode = -1;
+    if (fgets(line, sizeof(line), fp)) {
+        if (strstr(line, "[always]")) mode = 0;
+        else if (strstr(line, "[madvise]")) mode = 1;
+        else if (strstr(line, "[never]")) mode = 2;
+    }
+    fclose(fp);
+    return mode;
+}
+
+static double vmstat_counter(const char* name) {
+    FILE* fp = fopen("/proc/vmstat", "r");
+    if (!fp) return BENCHMARK_METRIC_NA;
+
+    char key[64];
+    unsigned long long value;
+    double found = BENCHMARK_METRIC_NA;
+    while (fscanf(fp, "%63s %llu", key, &value) == 2) {
+        if (strcmp(key, name) == 0) {
+            found = (double)value;
+            break;
+        }
+    }
+    fclose(fp);
+    return found;
+}
+
+#ifdef __linux__
+/* Applies advice to every private anonymous read-write mapping, which covers
+ * the allocator's heap and arenas whichever way it obtained them. */
+static void madvise_anon_mappings(int advice) {
+    FILE* fp = fopen("/proc/self/maps", "r");
+    if (!fp) return;
+
+    char line[512];
+    while (fgets(line, sizeof(line), fp)) {
+        unsigned long start, end, inode;
+        char perms[8];
+        char path[256] = "";
+        if (sscanf(line, "%lx-%lx %7s %*s %*s %lu %255s", &start, &end, perms, &inode, path) < 4) continue;
+        if (perms[0] != 'r' || perms[1] != 'w' || perms[3] != 'p' || inode != 0) continue;
+        if (path[0] && strcmp(path, "[heap]") != 0) continue;
+        madvise((void*)start, end - start, advice);
+    }
+    fclose(fp);
+}
+#endif
+
+static void thp_run_mode(allocator_api_t* api, benchmark_config_t* cfg, thp_mode_t mode,
+                         thp_mode_result_t* out) {
+    memset(out, 0, sizeof(thp_mode_result_t));
+
+#ifdef __linux__
+    if (mode == THP_MODE_PRCTL_DISABLE && prctl(PR_SET_THP_DISABLE, 1, 0, 0, 0) != 0) return;
+#else
+    if (mode != THP_MODE_SYSFS) return;
+#endif
+
+    size_t ws_bytes = benchmark_param_size(cfg, "ws_mb", 256) * 1024 * 1024;
+    size_t accesses = benchmark_param_size(cfg, "accesses", 4 * 1024 * 1024);
+    double churn = benchmark_param_double(cfg, "churn", 0.25);
+
+    size_dist_t dist;
+    large_dist_init(&dist, cfg);
+    unsigned int seed = cfg->seed;
+
+    size_t capacity = ws_bytes / (dist.min_size ? dist.min_size : 1) + 1;
+    thp_block_t* blocks = malloc(capacity * sizeof(thp_block_t));
+    if (!blocks) return;
+
+    size_t rss_before = get_current_rss_kb();
+    size_t huge_before = get_anon_huge_kb();
+    double faults_before = vmstat_counter("thp_fault_alloc");
+
+    hr_timer_t timer;
+    size_t count = 0;
+    int ok = 1;
+    while (out->requested < ws_bytes && count < capacity) {
+        size_t size = thp_block_size(&dist, &seed);
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        char* ptr = api->malloc(size);
+        out->alloc_ns += hr_timer_end(&timer);
+        if (!ptr) {
+            ok = 0;
+            break;
+        }
+        blocks[count].ptr = ptr;
+        blocks[count].size = size;
+        count++;
+        out->allocs++;
+        out->requested += size;
+    }
+
+#ifdef __linux__
+    if (mode == THP_MODE_MADV_HUGEPAGE) madvise_anon_mappings(MADV_HUGEPAGE);
+    if (mode == THP_MODE_MADV_NOHUGEPAGE) madvise_anon_mappings(MADV_NOHUGEPAGE);
+#endif
+
+    /* First touch is where huge pages get faulted in (or not). */
+    double start = timer_now_ns();
+    for (size_t i = 0; i < count; i++) memset(blocks[i].ptr, 1, blocks[i].size);
+    out->populate_ns = timer_now_ns() - start;
+
+    /* Replace part of the working set so recycled memory is in the mix. */
+    size_t replaced = (size_t)(count * churn);
+    for (size_t r = 0; ok && r < replaced; r++) {
+        size_t i = xorshift32(&seed) % count;
+        api->free(blocks[i].ptr);
+        out->frees++;
+        out->requested -= blocks[i].size;
+
+        size_t size = thp_block_size(&dist, &seed);
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        blocks[i].ptr = api->malloc(size);
+        out->alloc_ns += hr_timer_end(&timer);
+        if (!blocks[i].ptr) {
+            blocks[i] = blocks[--count];
+            ok = 0;
+            break;
+        }
+        memset(blocks[i].ptr, 1, size);
+        blocks[i].size = size;
+        out->allocs++;
+        out->requested += size;
+    }
+
+    perf_counter_t loads, misses;
+    int have_loads = perf_counter_open(&loads, PERF_COUNTER_DTLB_LOADS) == 0;
+    int have_misses = perf_counter_open(&misses, PERF_COUNTER_DTLB_LOAD_MISSES) == 0;
+
+    /* ws_mb=0 leaves nothing to access. */
+    if (count == 0) accesses = 0;
+
+    uint64_t sum = 0;
+    perf_counter_start(&loads);
+    perf_counter_start(&misses);
+    start = timer_now_ns();
+    for (size_t a = 0; ok && a < accesses; a++) {
+        thp_block_t* block = &blocks[xorshift32(&seed) % count];
+        size_t offset = (xorshift32(&seed) % (block->size / sizeof(uint64_t))) * sizeof(uint64_t);
+        uint64_t* word = (uint64_t*)(block->ptr + offset);
+        sum += *word;
+        *word = sum;
+    }
+    out->access_ns = timer_now_ns() - start;
+    uint64_t miss_count = perf_counter_stop(&misses);
+    uint64_t load_count = perf_counter_stop(&loads);
+    out->dtlb_misses = have_misses ? (double)miss_count : BENCHMARK_METRIC_NA;
+    out->dtlb_loads = have_loads ? (double)load_count : BENCHMARK_METRIC_NA;
+    perf_counter_close(&loads);
+    perf_counter_close(&misses);
+    out->accesses = ok ? accesses : 0;
+
+    size_t rss_after = get_current_rss_kb();
+    size_t huge_after = get_anon_huge_kb();
+    double faults_after = vmstat_counter("thp_fault_alloc");
+
+    out->rss_kb = rss_after > rss_before ? rss_after - rss_before : 0;
+    out->anon_huge_kb = huge_after > huge_before ? huge_after - huge_before : 0;
+    out->thp_faults = (faults_before == BENCHMARK_METRIC_NA || faults_after == BENCHMARK_METRIC_NA)
+                          ? BENCHMARK_METRIC_NA : faults_after - faults_before;
+
+    for (size_t i = 0; i < count; i++) api->free(blocks[i].ptr);
+    out->frees += count;
+    free(blocks);
+
+    benchmark_do_not_optimize(sum);
+    out->ok = ok;
+}
+
+/* Each variation runs in a forked child where fork is available: prctl and
+ * madvise flags stick to the process and its mappings, so running them in
+ * place would leak into every later mode and benchmark. */
+static void thp_run_isolated(allocator_api_t* api, benchmark_config_t* cfg, thp_mode_t mode,
+                             thp_mode_result_t* out) {
+#ifdef __linux__
+    int fds[2];
+    memset(out, 0, sizeof(thp_mode_result_t));
+    if (pipe(fds) != 0) return;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        thp_mode_result_t child;
+        thp_run_mode(api, cfg, mode, &child);
+        ssize_t written = write(fds[1], &child, sizeof(child));
+        close(fds[1]);
+        _exit(written == (ssize_t)sizeof(child) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    if (pid > 0) {
+        if (read(fds[0], out, sizeof(thp_mode_result_t)) != (ssize_t)sizeof(thp_mode_result_t)) {
+            memset(out, 0, sizeof(thp_mode_result_t));
+        }
+        waitpid(pid, NULL, 0);
+    }
+    close(fds[0]);
+#else
+    thp_run_mode(api, cfg, mode, out);
+#endif
+}
+
+int bench_thp_working_set(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &thp_config;
+
+    thp_mode_result_t modes[4];
+    size_t total_allocs = 0, total_frees = 0, total_accesses = 0, requested = 0;
+    double alloc_ns = 0, access_ns = 0;
+    int any_ok = 0;
+
+    for (int m = 0; m < 4; m++) {
+        thp_run_isolated(api, cfg, (thp_mode_t)m, &modes[m]);
+        if (!modes[m].ok) continue;
+        any_ok = 1;
+        total_allocs += modes[m].allocs;
+        total_frees += modes[m].frees;
+        total_accesses += modes[m].accesses;
+        alloc_ns += modes[m].alloc_ns;
+        access_ns += modes[m].access_ns;
+        if (modes[m].requested > requested) requested = modes[m].requested;
+    }
+    if (!any_ok) return -1;
+
+    result->operations_count = total_accesses;
+    result->thread_count = 1;
+    result->alloc_ops_per_sec = total_allocs ? (double)total_allocs / (alloc_ns / 1e9) : BENCHMARK_METRIC_NA;
+    result->free_ops_per_sec = BENCHMARK_METRIC_NA;
+    result->total_ops_per_sec = total_accesses ? (double)total_accesses / (access_ns / 1e9) : BENCHMARK_METRIC_NA;
+    result->avg_alloc_time_ns = total_allocs ? alloc_ns / total_allocs : BENCHMARK_METRIC_NA;
+    result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->total_requested_bytes = requested;
+    result->total_allocated_bytes = requested;
+    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+    benchmark_result_add_metric(result, "thp_sysfs_mode", (double)thp_sysfs_mode());
+
+    char name[MAX_METRIC_NAME];
+    for (int m = 0; m < 4; m++) {
+        const thp_mode_result_t* r = &modes[m];
+        const char* label = thp_mode_labels[m];
+        int ok = r->ok && r->accesses > 0;
+
+        snprintf(name, sizeof(name), "%s_access_ns", label);
+        benchmark_result_add_metric(result, name, ok ? r->access_ns / r->accesses : BENCHMARK_METRIC_NA);
+        snprintf(name, sizeof(name), "%s_populate_gbps", label);
+        benchmark_result_add_metric(result, name, ok ? r->requested / (r->populate_ns / 1e9) / 1e9 : BENCHMARK_METRIC_NA);
+        snprintf(name, sizeof(name), "%s_anon_huge_mb", label);
+        benchmark_result_add_metric(result, name, ok ? r->anon_huge_kb / 1024.0 : BENCHMARK_METRIC_NA);
+        snprintf(name, sizeof(name), "%s_rss_inflation", label);
+        benchmark_result_add_metric(result, name, ok && r->requested ? r->rss_kb * 1024.0 / r->requested : BENCHMARK_METRIC_NA);
+        snprintf(name, sizeof(name), "%s_thp_faults", label);
+        benchmark_result_add_metric(result, name, ok ? r->thp_faults : BENCHMARK_METRIC_NA);
+        snprintf(name, sizeof(name), "%s_dtlb_miss_rate", label);
+        benchmark_result_add_metric(result, name,
+                                    ok && r->dtlb_misses != BENCHMARK_METRIC_NA && r->dtlb_loads > 0
+                                        ? r->dtlb_misses / r->dtlb_loads : BENCHMARK_METRIC_NA);
+        snprintf(name, sizeof(name), "%s_dtlb_miss_per_acc", label);
+        benchmark_result_add_metric(result, name,
+                                    ok && r->dtlb_misses != BENCHMARK_METRIC_NA
+                                        ? r->dtlb_misses / r->accesses : BENCHMARK_METRIC_NA);
+    }
+
+    return 0;
+}
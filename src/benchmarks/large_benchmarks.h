@@ -0,0 +1,13 @@
+#ifndef LARGE_BENCHMARKS_H
+#define LARGE_BENCHMARKS_H
+
+#include "../benchmark.h"
+
+void register_large_benchmarks(void);
+
+int bench_large_churn(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_large_touch(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_large_realloc(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_thp_working_set(allocator_api_t* api, benchmark_result_t* result, void* config);
+
+#endif
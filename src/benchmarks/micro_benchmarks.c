@@ -1,6 +1,10 @@
 #include "micro_benchmarks.h"
 #include "timer.h"
 #include "memory_stats.h"
+#include "timeseries.h"
+#include "size_dist.h"
+#include "latency.h"
+#include "syscall_stats.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -9,6 +13,17 @@
 
 static benchmark_config_t default_config = BENCHMARK_DEFAULT_CONFIG;
 
+static benchmark_config_t calloc_large_config = {
+    .iterations = 1000000,
+    .min_size = 128 * 1024,
+    .max_size = 16 * 1024 * 1024,
+    .thread_count = 1,
+    .seed = 42,
+    .sample_interval_ms = 0,
+    .params = "live_mb=256",
+    .size_dist = NULL
+};
+
 static unsigned int xorshift32(unsigned int* state) {
     unsigned int x = *state;
     x ^= x << 13;
@@ -18,10 +33,6 @@ static unsigned int xorshift32(unsigned int* state) {
     return x;
 }
 
-static size_t random_size(unsigned int* state, size_t min_size, size_t max_size) {
-    return min_size + (xorshift32(state) % (max_size - min_size + 1));
-}
-
 static int compare_doubles(const void* a, const void* b) {
     double diff = *(const double*)a - *(const double*)b;
     return (diff > 0) - (diff < 0);
@@ -54,7 +65,7 @@ void register_micro_benchmarks(void) {
 
     static benchmark_t bench4 = {
         .name = "aligned_alloc",
-        .description = "Aligned allocation benchmark",
+        .description = "Aligned allocation and free per alignment, 16 B to 1 GB",
         .run = bench_aligned_alloc_benchmark,
         .default_config = &default_config
     };
@@ -67,14 +78,62 @@ void register_micro_benchmarks(void) {
         .default_config = &default_config
     };
     benchmark_register(&bench5);
+
+    static benchmark_t bench6 = {
+        .name = "calloc_small",
+        .description = "calloc vs malloc+memset, small blocks, fresh and recycled",
+        .run = bench_calloc_small,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench6);
+
+    static benchmark_t bench7 = {
+        .name = "calloc_large",
+        .description = "calloc vs malloc+memset, 128 KB-16 MB blocks, fresh and recycled",
+        .run = bench_calloc_large,
+        .default_config = &calloc_large_config
+    };
+    benchmark_register(&bench7);
+
+    static benchmark_t bench8 = {
+        .name = "realloc_grow_1_5x",
+        .description = "Many live buffers grown 1.5x at a time with interleaved allocations",
+        .run = bench_realloc_grow_1_5x,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench8);
+
+    static benchmark_t bench9 = {
+        .name = "realloc_grow_2x",
+        .description = "Many live buffers grown 2x at a time with interleaved allocations",
+        .run = bench_realloc_grow_2x,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench9);
+
+    static benchmark_t bench10 = {
+        .name = "realloc_grow_step",
+        .description = "Many live buffers grown by small fixed steps with interleaved allocations",
+        .run = bench_realloc_grow_step,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench10);
+
+    static benchmark_t bench11 = {
+        .name = "realloc_shrink",
+        .description = "Many live buffers shrunk 0.75x at a time with interleaved allocations",
+        .run = bench_realloc_shrink,
+        .default_config = &default_config
+    };
+    benchmark_register(&bench11);
 }
 
 int bench_sequential_alloc(allocator_api_t* api, benchmark_result_t* result, void* config) {
     benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
 
     size_t iterations = cfg->iterations;
-    size_t min_size = cfg->min_size;
-    size_t max_size = cfg->max_size;
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
     unsigned int seed = cfg->seed;
 
     void** ptrs = malloc(iterations * sizeof(void*));
@@ -97,8 +156,11 @@ int bench_sequential_alloc(allocator_api_t* api, benchmark_result_t* result, voi
     double min_time = 1e30;
     double max_time = 0;
 
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
     for (size_t i = 0; i < iterations; i++) {
-        sizes[i] = random_size(&seed, min_size, max_size);
+        sizes[i] = size_dist_sample(&dist, &seed);
         total_requested += sizes[i];
 
         hr_timer_init(&timer);
@@ -119,6 +181,7 @@ int bench_sequential_alloc(allocator_api_t* api, benchmark_result_t* result, voi
         total_alloc_time_ns += alloc_times[i];
         if (alloc_times[i] < min_time) min_time = alloc_times[i];
         if (alloc_times[i] > max_time) max_time = alloc_times[i];
+        series_sampler_add(&sampler, 1);
     }
 
     qsort(alloc_times, iterations, sizeof(double), compare_doubles);
@@ -139,8 +202,10 @@ int bench_sequential_alloc(allocator_api_t* api, benchmark_result_t* result, voi
     hr_timer_start(&timer);
     for (size_t i = 0; i < iterations; i++) {
         api->free(ptrs[i]);
+        series_sampler_add(&sampler, 1);
     }
     free_time_ns = hr_timer_end(&timer);
+    series_sampler_finish(&sampler);
 
     result->free_ops_per_sec = (double)iterations / (free_time_ns / 1e9);
     result->total_ops_per_sec = (double)(iterations * 2) / ((total_alloc_time_ns + free_time_ns) / 1e9);
@@ -155,8 +220,8 @@ int bench_random_alloc(allocator_api_t* api, benchmark_result_t* result, void* c
     benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
 
     size_t iterations = cfg->iterations;
-    size_t min_size = cfg->min_size;
-    size_t max_size = cfg->max_size;
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
     unsigned int seed = cfg->seed;
 
     size_t active_count = iterations / 4;
@@ -187,6 +252,9 @@ int bench_random_alloc(allocator_api_t* api, benchmark_result_t* result, void* c
     double* alloc_times = malloc(iterations * sizeof(double));
     size_t alloc_time_idx = 0;
 
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
     for (size_t i = 0; i < iterations; i++) {
         size_t slot = xorshift32(&seed) % active_count;
 
@@ -199,7 +267,7 @@ int bench_random_alloc(allocator_api_t* api, benchmark_result_t* result, void* c
             free_count++;
         }
 
-        size_t size = random_size(&seed, min_size, max_size);
+        size_t size = size_dist_sample(&dist, &seed);
         total_requested += size;
 
         hr_timer_init(&timer);
@@ -216,7 +284,9 @@ int bench_random_alloc(allocator_api_t* api, benchmark_result_t* result, void* c
                 alloc_times[alloc_time_idx++] = time;
             }
         }
+        series_sampler_add(&sampler, 2);
     }
+    series_sampler_finish(&sampler);
 
     for (size_t i = 0; i < active_count; i++) {
         if (active_ptrs[i]) {
@@ -249,23 +319,26 @@ int bench_realloc_benchmark(allocator_api_t* api, benchmark_result_t* result, vo
     benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
 
     size_t iterations = cfg->iterations;
-    size_t min_size = cfg->min_size;
-    size_t max_size = cfg->max_size;
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
     unsigned int seed = cfg->seed;
 
-    void* ptr = api->malloc(min_size);
+    void* ptr = api->malloc(dist.min_size);
     if (!ptr) return -1;
 
-    size_t current_size = min_size;
+    size_t current_size = dist.min_size;
     double total_time_ns = 0;
-    size_t total_requested = min_size;
+    size_t total_requested = dist.min_size;
 
     hr_timer_t timer;
     double* times = malloc(iterations * sizeof(double));
     double min_time = 1e30, max_time = 0;
 
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
     for (size_t i = 0; i < iterations; i++) {
-        size_t new_size = random_size(&seed, min_size, max_size);
+        size_t new_size = size_dist_sample(&dist, &seed);
         total_requested += new_size > current_size ? new_size - current_size : 0;
 
         hr_timer_init(&timer);
@@ -283,7 +356,9 @@ int bench_realloc_benchmark(allocator_api_t* api, benchmark_result_t* result, vo
         } else {
             times[i] = 0;
         }
+        series_sampler_add(&sampler, 1);
     }
+    series_sampler_finish(&sampler);
 
     api->free(ptr);
 
@@ -309,96 +384,189 @@ int bench_realloc_benchmark(allocator_api_t* api, benchmark_result_t* result, vo
     return 0;
 }
 
+typedef struct {
+    size_t alignment;
+    const char* label;
+    size_t default_blocks; /* 0: share of the iteration count */
+} alignment_class_t;
+
+/* The large classes stand in for huge-page and DMA buffers; only a handful
+ * are live at once since each may reserve far more address space than it uses. */
+static const alignment_class_t alignment_classes[] = {
+    {16, "a16", 0},
+    {32, "a32", 0},
+    {64, "a64", 0},
+    {128, "a128", 0},
+    {256, "a256", 0},
+    {512, "a512", 0},
+    {1024, "a1k", 0},
+    {4096, "a4k", 0},
+    {64 * 1024, "a64k", 256},
+    {2 * 1024 * 1024, "a2m", 32},
+    {1024 * 1024 * 1024, "a1g", 4}
+};
+
 int bench_aligned_alloc_benchmark(allocator_api_t* api, benchmark_result_t* result, void* config) {
     benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
 
-    size_t iterations = cfg->iterations / 10;
-    if (iterations < 100) iterations = 100;
+    size_t num_classes = sizeof(alignment_classes) / sizeof(alignment_classes[0]);
+    size_t max_alignment = benchmark_param_size(cfg, "max_align", 1024 * 1024 * 1024);
+
+    size_t small_classes = 0;
+    for (size_t c = 0; c < num_classes; c++) {
+        if (alignment_classes[c].default_blocks == 0) small_classes++;
+    }
+    size_t small_blocks = cfg->iterations / 10 / small_classes;
+    if (small_blocks < 100) small_blocks = 100;
 
-    size_t min_size = cfg->min_size;
-    size_t max_size = cfg->max_size;
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
     unsigned int seed = cfg->seed;
 
-    void** ptrs = malloc(iterations * sizeof(void*));
-    double* times = malloc(iterations * sizeof(double));
-    if (!ptrs || !times) {
+    void** ptrs = malloc(small_blocks * sizeof(void*));
+    latency_recorder_t all_lat;
+    if (!ptrs || latency_recorder_init(&all_lat, 65536) != 0) {
         free(ptrs);
-        free(times);
         return -1;
     }
 
-    size_t alignments[] = {16, 32, 64, 128, 256, 512, 1024, 4096};
-    size_t num_alignments = sizeof(alignments) / sizeof(alignments[0]);
-
     hr_timer_t timer;
-    double total_time_ns = 0;
+    double total_alloc_ns = 0, total_free_ns = 0;
+    size_t total_allocs = 0, total_failures = 0;
     size_t total_requested = 0;
-    double min_time = 1e30, max_time = 0;
+    int ok = 1;
+
+    /* Grow the heap to the working-set size with plain malloc first, so each
+     * alignment's address-space growth is what alignment costs on top of it. */
+    for (size_t i = 0; i < small_blocks; i++) {
+        size_t size = size_dist_sample(&dist, &seed);
+        ptrs[i] = api->malloc(size);
+        if (ptrs[i]) memset(ptrs[i], 0, size);
+    }
+    for (size_t i = 0; i < small_blocks; i++) api->free(ptrs[i]);
+    seed = cfg->seed;
+
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
+    /* One alignment at a time, so latency, free cost and the address space
+     * grown while the blocks are live can be attributed to it. */
+    for (size_t c = 0; c < num_classes && ok; c++) {
+        const alignment_class_t* cls = &alignment_classes[c];
+        if (cls->alignment > max_alignment) continue;
+
+        char name[MAX_METRIC_NAME];
+        size_t blocks = small_blocks;
+        if (cls->default_blocks) {
+            snprintf(name, sizeof(name), "%s_blocks", cls->label);
+            blocks = benchmark_param_size(cfg, name, cls->default_blocks);
+            if (blocks > small_blocks) blocks = small_blocks;
+        }
 
-    for (size_t i = 0; i < iterations; i++) {
-        size_t size = random_size(&seed, min_size, max_size);
-        size_t align = alignments[xorshift32(&seed) % num_alignments];
-        total_requested += size;
+        latency_recorder_t lat;
+        if (latency_recorder_init(&lat, blocks < 16384 ? blocks : 16384) != 0) {
+            ok = 0;
+            break;
+        }
 
-        hr_timer_init(&timer);
-        hr_timer_start(&timer);
-        ptrs[i] = api->aligned_alloc(align, size);
-        times[i] = hr_timer_end(&timer);
-        total_time_ns += times[i];
+        size_t vm_before = get_virtual_size_kb();
+        size_t requested = 0, failures = 0, live = 0;
+        double free_ns = 0;
 
-        if (times[i] < min_time) min_time = times[i];
-        if (times[i] > max_time) max_time = times[i];
+        for (size_t i = 0; i < blocks; i++) {
+            size_t size = size_dist_sample(&dist, &seed);
 
-        if (!ptrs[i]) {
-            for (size_t j = 0; j < i; j++) {
-                api->aligned_free(ptrs[j]);
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            void* ptr = api->aligned_alloc(cls->alignment, size);
+            double elapsed = hr_timer_end(&timer);
+            series_sampler_add(&sampler, 1);
+
+            if (!ptr || ((uintptr_t)ptr & (cls->alignment - 1)) != 0) {
+                if (ptr) api->aligned_free(ptr);
+                failures++;
+                continue;
             }
-            free(ptrs);
-            free(times);
-            return -1;
+            memset(ptr, 0, size);
+            ptrs[live++] = ptr;
+            requested += size;
+            latency_recorder_add(&lat, elapsed);
+            latency_recorder_add(&all_lat, elapsed);
         }
-    }
 
-    for (size_t i = 0; i < iterations; i++) {
-        api->aligned_free(ptrs[i]);
+        size_t vm_after = get_virtual_size_kb();
+        memory_stats_sample();
+
+        for (size_t i = 0; i < live; i++) {
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            api->aligned_free(ptrs[i]);
+            free_ns += hr_timer_end(&timer);
+            series_sampler_add(&sampler, 1);
+        }
+
+        double vm_grown = vm_after > vm_before ? (double)(vm_after - vm_before) : 0.0;
+
+        snprintf(name, sizeof(name), "%s_alloc_ns", cls->label);
+        benchmark_result_add_metric(result, name, live ? latency_recorder_mean(&lat) : BENCHMARK_METRIC_NA);
+        snprintf(name, sizeof(name), "%s_alloc_p99_ns", cls->label);
+        benchmark_result_add_metric(result, name, live ? latency_recorder_percentile(&lat, 0.99) : BENCHMARK_METRIC_NA);
+        snprintf(name, sizeof(name), "%s_free_ns", cls->label);
+        benchmark_result_add_metric(result, name, live ? free_ns / live : BENCHMARK_METRIC_NA);
+        snprintf(name, sizeof(name), "%s_vm_per_block_kb", cls->label);
+        benchmark_result_add_metric(result, name, live ? vm_grown / live : BENCHMARK_METRIC_NA);
+
+        total_alloc_ns += lat.total;
+        total_free_ns += free_ns;
+        total_allocs += live;
+        total_failures += failures;
+        total_requested += requested;
+        latency_recorder_destroy(&lat);
     }
+    series_sampler_finish(&sampler);
 
     free(ptrs);
 
-    qsort(times, iterations, sizeof(double), compare_doubles);
-
-    result->operations_count = iterations * 2;
-    result->thread_count = 1;
-    result->alloc_ops_per_sec = (double)iterations / (total_time_ns / 1e9);
-    result->total_ops_per_sec = result->alloc_ops_per_sec;
-    result->avg_alloc_time_ns = total_time_ns / iterations;
-    result->min_alloc_time_ns = min_time;
-    result->max_alloc_time_ns = max_time;
-    result->p50_alloc_time_ns = times[iterations / 2];
-    result->p99_alloc_time_ns = times[(size_t)(iterations * 0.99)];
-    result->total_requested_bytes = total_requested;
-    result->total_allocated_bytes = total_requested;
-    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+    if (ok && total_allocs > 0) {
+        result->operations_count = total_allocs * 2;
+        result->thread_count = 1;
+        result->alloc_ops_per_sec = (double)total_allocs / (total_alloc_ns / 1e9);
+        result->free_ops_per_sec = (double)total_allocs / (total_free_ns / 1e9);
+        result->total_ops_per_sec = (double)result->operations_count / ((total_alloc_ns + total_free_ns) / 1e9);
+        result->avg_alloc_time_ns = total_alloc_ns / total_allocs;
+        result->min_alloc_time_ns = all_lat.min;
+        result->max_alloc_time_ns = all_lat.max;
+        result->p50_alloc_time_ns = latency_recorder_percentile(&all_lat, 0.50);
+        result->p99_alloc_time_ns = latency_recorder_percentile(&all_lat, 0.99);
+        result->total_requested_bytes = total_requested;
+        result->total_allocated_bytes = total_requested;
+        result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+        benchmark_result_add_metric(result, "align_failures", (double)total_failures);
+    }
 
-    free(times);
+    latency_recorder_destroy(&all_lat);
 
-    return 0;
+    return ok && total_allocs > 0 ? 0 : -1;
 }
 
 int bench_alloc_free_immediate(allocator_api_t* api, benchmark_result_t* result, void* config) {
     benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
 
     size_t iterations = cfg->iterations;
-    size_t min_size = cfg->min_size;
-    size_t max_size = cfg->max_size;
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
     unsigned int seed = cfg->seed;
 
     hr_timer_t timer;
     double total_time_ns = 0;
     size_t total_requested = 0;
 
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
     for (size_t i = 0; i < iterations; i++) {
-        size_t size = random_size(&seed, min_size, max_size);
+        size_t size = size_dist_sample(&dist, &seed);
         total_requested += size;
 
         hr_timer_init(&timer);
@@ -408,7 +576,9 @@ int bench_alloc_free_immediate(allocator_api_t* api, benchmark_result_t* result,
             api->free(ptr);
         }
         total_time_ns += hr_timer_end(&timer);
+        series_sampler_add(&sampler, 2);
     }
+    series_sampler_finish(&sampler);
 
     result->operations_count = iterations * 2;
     result->thread_count = 1;
@@ -424,3 +594,495 @@ int bench_alloc_free_immediate(allocator_api_t* api, benchmark_result_t* result,
 
     return 0;
 }
+
+typedef struct {
+    const char* name;
+    latency_recorder_t lat;
+    double alloc_ns;
+    double free_ns;
+    size_t bytes;
+    size_t faults;
+    double touch_ns;
+    size_t touch_faults;
+} zero_wave_t;
+
+/* Allocates a wave of zeroed blocks, then writes one byte per page so any
+ * zeroing the allocator deferred to the first page fault shows up too. */
+static int run_zero_wave(allocator_api_t* api, int use_calloc, void** ptrs,
+                         const size_t* sizes, size_t count, zero_wave_t* wave) {
+    size_t page = get_page_size();
+    hr_timer_t timer;
+
+    size_t faults_before = get_page_faults();
+    for (size_t i = 0; i < count; i++) {
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        if (use_calloc) {
+            ptrs[i] = api->calloc(1, sizes[i]);
+        } else {
+            ptrs[i] = api->malloc(sizes[i]);
+            if (ptrs[i]) memset(ptrs[i], 0, sizes[i]);
+        }
+        double elapsed = hr_timer_end(&timer);
+
+        if (!ptrs[i]) {
+            for (size_t j = 0; j < i; j++) api->free(ptrs[j]);
+            return -1;
+        }
+        latency_recorder_add(&wave->lat, elapsed);
+        wave->alloc_ns += elapsed;
+        wave->bytes += sizes[i];
+    }
+    wave->faults += get_page_faults() - faults_before;
+
+    faults_before = get_page_faults();
+    hr_timer_init(&timer);
+    hr_timer_start(&timer);
+    for (size_t i = 0; i < count; i++) {
+        volatile char* bytes = ptrs[i];
+        for (size_t off = 0; off < sizes[i]; off += page) bytes[off] = 1;
+    }
+    wave->touch_ns += hr_timer_end(&timer);
+    wave->touch_faults += get_page_faults() - faults_before;
+
+    return 0;
+}
+
+static void free_zero_wave(allocator_api_t* api, void** ptrs, size_t count, zero_wave_t* wave) {
+    hr_timer_t timer;
+    hr_timer_init(&timer);
+    hr_timer_start(&timer);
+    for (size_t i = 0; i < count; i++) api->free(ptrs[i]);
+    wave->free_ns += hr_timer_end(&timer);
+}
+
+static void report_zero_wave(benchmark_result_t* result, zero_wave_t* wave, size_t count) {
+    char name[MAX_METRIC_NAME];
+
+    snprintf(name, sizeof(name), "%s_ns", wave->name);
+    benchmark_result_add_metric(result, name, latency_recorder_mean(&wave->lat));
+    snprintf(name, sizeof(name), "%s_p99_ns", wave->name);
+    benchmark_result_add_metric(result, name, latency_recorder_percentile(&wave->lat, 0.99));
+    snprintf(name, sizeof(name), "%s_gb_per_sec", wave->name);
+    benchmark_result_add_metric(result, name, wave->bytes / wave->alloc_ns);
+    snprintf(name, sizeof(name), "%s_faults", wave->name);
+    benchmark_result_add_metric(result, name, (double)wave->faults);
+    snprintf(name, sizeof(name), "%s_touch_ns", wave->name);
+    benchmark_result_add_metric(result, name, wave->touch_ns / count);
+    snprintf(name, sizeof(name), "%s_touch_faults", wave->name);
+    benchmark_result_add_metric(result, name, (double)wave->touch_faults);
+}
+
+/* Both fresh waves are allocated while the other is still live, so neither
+ * can reuse the other's memory; each recycled wave then lands in the blocks
+ * its own fresh wave just freed. */
+static int run_calloc_benchmark(allocator_api_t* api, benchmark_result_t* result,
+                                benchmark_config_t* cfg, const char* default_spec) {
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist ? cfg->size_dist : default_spec,
+                       cfg->min_size, cfg->max_size) != 0) return -1;
+    unsigned int seed = cfg->seed;
+
+    size_t live_bytes = benchmark_param_size(cfg, "live_mb", 64) * 1024 * 1024;
+    size_t count = (size_t)(live_bytes / dist.mean_size);
+    if (count > cfg->iterations) count = cfg->iterations;
+    if (count < 1) count = 1;
+
+    size_t* sizes = malloc(count * sizeof(size_t));
+    void** calloc_ptrs = malloc(count * sizeof(void*));
+    void** memset_ptrs = malloc(count * sizeof(void*));
+    zero_wave_t waves[4] = {
+        { .name = "calloc_fresh" },
+        { .name = "memset_fresh" },
+        { .name = "calloc_reuse" },
+        { .name = "memset_reuse" }
+    };
+    int ok = sizes && calloc_ptrs && memset_ptrs;
+    for (int w = 0; w < 4; w++) {
+        if (latency_recorder_init(&waves[w].lat, 16384) != 0) ok = 0;
+    }
+
+    if (ok) {
+        for (size_t i = 0; i < count; i++) sizes[i] = size_dist_sample(&dist, &seed);
+
+        ok = run_zero_wave(api, 1, calloc_ptrs, sizes, count, &waves[0]) == 0;
+        if (ok && run_zero_wave(api, 0, memset_ptrs, sizes, count, &waves[1]) != 0) {
+            free_zero_wave(api, calloc_ptrs, count, &waves[0]);
+            ok = 0;
+        }
+        if (ok) {
+            free_zero_wave(api, calloc_ptrs, count, &waves[0]);
+            if (run_zero_wave(api, 1, calloc_ptrs, sizes, count, &waves[2]) != 0) {
+                free_zero_wave(api, memset_ptrs, count, &waves[1]);
+                ok = 0;
+            }
+        }
+        if (ok) {
+            free_zero_wave(api, memset_ptrs, count, &waves[1]);
+            if (run_zero_wave(api, 0, memset_ptrs, sizes, count, &waves[3]) != 0) {
+                free_zero_wave(api, calloc_ptrs, count, &waves[2]);
+                ok = 0;
+            }
+        }
+        if (ok) {
+            memory_stats_sample();
+            free_zero_wave(api, calloc_ptrs, count, &waves[2]);
+            free_zero_wave(api, memset_ptrs, count, &waves[3]);
+        }
+    }
+
+    if (ok) {
+        double alloc_ns = 0, free_ns = 0;
+        for (int w = 0; w < 4; w++) {
+            alloc_ns += waves[w].alloc_ns;
+            free_ns += waves[w].free_ns;
+        }
+
+        latency_recorder_t calloc_lat;
+        if (latency_recorder_init(&calloc_lat, 32768) == 0) {
+            latency_recorder_merge(&calloc_lat, &waves[0].lat);
+            latency_recorder_merge(&calloc_lat, &waves[2].lat);
+            result->avg_alloc_time_ns = latency_recorder_mean(&calloc_lat);
+            result->min_alloc_time_ns = calloc_lat.min;
+            result->max_alloc_time_ns = calloc_lat.max;
+            result->p50_alloc_time_ns = latency_recorder_percentile(&calloc_lat, 0.50);
+            result->p99_alloc_time_ns = latency_recorder_percentile(&calloc_lat, 0.99);
+            latency_recorder_destroy(&calloc_lat);
+        }
+
+        result->operations_count = count * 8;
+        result->thread_count = 1;
+        result->alloc_ops_per_sec = (double)(count * 4) / (alloc_ns / 1e9);
+        result->free_ops_per_sec = (double)(count * 4) / (free_ns / 1e9);
+        result->total_ops_per_sec = (double)(count * 8) / ((alloc_ns + free_ns) / 1e9);
+        result->total_requested_bytes = waves[0].bytes * 4;
+        result->total_allocated_bytes = result->total_requested_bytes;
+        result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+        benchmark_result_add_metric(result, "blocks_per_wave", (double)count);
+        for (int w = 0; w < 4; w++) report_zero_wave(result, &waves[w], count);
+    }
+
+    for (int w = 0; w < 4; w++) latency_recorder_destroy(&waves[w].lat);
+    free(sizes);
+    free(calloc_ptrs);
+    free(memset_ptrs);
+    return ok ? 0 : -1;
+}
+
+int bench_calloc_small(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+    return run_calloc_benchmark(api, result, cfg, NULL);
+}
+
+int bench_calloc_large(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &calloc_large_config;
+
+    char spec[SIZE_DIST_MAX_SPEC];
+    snprintf(spec, sizeof(spec), "loguniform:%zu-%zu", cfg->min_size, cfg->max_size);
+    return run_calloc_benchmark(api, result, cfg, spec);
+}
+
+typedef enum {
+    REALLOC_GROW_1_5X,
+    REALLOC_GROW_2X,
+    REALLOC_GROW_STEP,
+    REALLOC_SHRINK
+} realloc_pattern_t;
+
+typedef struct {
+    char* ptr;
+    size_t size;
+    size_t lo;
+    size_t hi;
+    int large;
+} grow_buffer_t;
+
+typedef struct {
+    latency_recorder_t lat;
+    double time_ns;
+    size_t count;
+    size_t in_place;
+    size_t bytes_copied;
+    size_t remapped;
+} realloc_stats_t;
+
+/* Best of a few copies between two warm buffers. */
+static double memcpy_bytes_per_ns(size_t bytes) {
+    char* src = malloc(bytes);
+    char* dst = malloc(bytes);
+    double best = 0;
+    if (src && dst) {
+        memset(src, 0x5a, bytes);
+        memset(dst, 0, bytes);
+        for (int round = 0; round < 4; round++) {
+            double start = timer_now_ns();
+            memcpy(dst, src, bytes);
+            double rate = (double)bytes / (timer_now_ns() - start);
+            if (rate > best) best = rate;
+        }
+    }
+    free(src);
+    free(dst);
+    return best;
+}
+
+static size_t next_realloc_size(realloc_pattern_t pattern, size_t size, size_t step) {
+    switch (pattern) {
+        case REALLOC_GROW_1_5X: return size + size / 2 + 1;
+        case REALLOC_GROW_2X: return size * 2;
+        case REALLOC_GROW_STEP: return size + step;
+        default: return size * 3 / 4;
+    }
+}
+
+/* Writes the bytes a caller would fill after growing: the whole tail for
+ * small buffers, one byte per page for large ones. */
+static void fill_tail(char* ptr, size_t from, size_t to, int large) {
+    if (to <= from) return;
+    if (!large) {
+        memset(ptr + from, 0x5a, to - from);
+        return;
+    }
+    size_t page = get_page_size();
+    for (size_t off = from; off < to; off += page) ptr[off] = 0x5a;
+    ptr[to - 1] = 0x5a;
+}
+
+/* Buffers start at the edge of their range opposite the direction of travel
+ * and are freed and restarted (like a finished string builder) once the next
+ * step would leave it. */
+static int restart_buffer(allocator_api_t* api, grow_buffer_t* buf, realloc_pattern_t pattern) {
+    api->free(buf->ptr);
+    buf->size = pattern == REALLOC_SHRINK ? buf->hi : buf->lo;
+    buf->ptr = api->malloc(buf->size);
+    if (!buf->ptr) return -1;
+    fill_tail(buf->ptr, 0, buf->size, buf->large);
+    return 0;
+}
+
+static void report_realloc_stats(benchmark_result_t* result, const char* prefix, realloc_stats_t* stats) {
+    char name[MAX_METRIC_NAME];
+
+    snprintf(name, sizeof(name), "%sreallocs", prefix);
+    benchmark_result_add_metric(result, name, (double)stats->count);
+    snprintf(name, sizeof(name), "%sin_place_fraction", prefix);
+    benchmark_result_add_metric(result, name, stats->count ? (double)stats->in_place / stats->count : BENCHMARK_METRIC_NA);
+    snprintf(name, sizeof(name), "%smoved", prefix);
+    benchmark_result_add_metric(result, name, (double)(stats->count - stats->in_place));
+    snprintf(name, sizeof(name), "%sbytes_copied_mb", prefix);
+    benchmark_result_add_metric(result, name, stats->bytes_copied / (1024.0 * 1024.0));
+    snprintf(name, sizeof(name), "%savg_ns", prefix);
+    benchmark_result_add_metric(result, name, stats->count ? latency_recorder_mean(&stats->lat) : BENCHMARK_METRIC_NA);
+    snprintf(name, sizeof(name), "%sp99_ns", prefix);
+    benchmark_result_add_metric(result, name, stats->count ? latency_recorder_percentile(&stats->lat, 0.99) : BENCHMARK_METRIC_NA);
+}
+
+/* A moved large block is counted as remapped when the realloc took less than
+ * half of what copying its bytes at memcpy bandwidth would have; syscall
+ * counters cannot tell, since glibc issues mremap internally where --wrap
+ * does not see it. */
+#define REALLOC_REMAP_COPY_FRACTION 0.5
+
+/* A few of the buffers live in the large range, where allocators that map
+ * blocks directly can grow with mremap instead of copying. They are resized
+ * every large_every operations so the copy cost stays bounded. */
+static int run_realloc_pattern(allocator_api_t* api, benchmark_result_t* result,
+                               benchmark_config_t* cfg, realloc_pattern_t pattern) {
+    size_t iterations = cfg->iterations;
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
+    unsigned int seed = cfg->seed;
+
+    size_t buffer_count = benchmark_param_size(cfg, "buffers", 256);
+    size_t large_count = benchmark_param_size(cfg, "large_buffers", 4);
+    size_t large_every = benchmark_param_size(cfg, "large_every", 2048);
+    size_t interleave = benchmark_param_size(cfg, "interleave", 1);
+    size_t step = benchmark_param_size(cfg, "step", 64);
+    size_t small_max = benchmark_param_size(cfg, "buffer_max", 64 * 1024);
+    size_t large_min = benchmark_param_size(cfg, "large_min", 256 * 1024);
+    size_t large_max = benchmark_param_size(cfg, "large_max", 64 * 1024 * 1024);
+    if (buffer_count < 1) buffer_count = 1;
+    if (large_count >= buffer_count) large_count = buffer_count - 1;
+    if (large_every < 1) large_every = 1;
+    if (step < 1) step = 1;
+
+    size_t small_min = pattern == REALLOC_SHRINK ? dist.min_size : 16;
+    if (small_max <= small_min) small_max = small_min * 2;
+    if (large_max <= large_min) large_max = large_min * 2;
+
+    grow_buffer_t* buffers = calloc(buffer_count, sizeof(grow_buffer_t));
+    void** fillers = calloc(buffer_count, sizeof(void*));
+    realloc_stats_t small_stats, large_stats;
+    memset(&small_stats, 0, sizeof(small_stats));
+    memset(&large_stats, 0, sizeof(large_stats));
+
+    int ok = buffers && fillers &&
+             latency_recorder_init(&small_stats.lat, 16384) == 0 &&
+             latency_recorder_init(&large_stats.lat, 16384) == 0;
+
+    for (size_t b = 0; ok && b < buffer_count; b++) {
+        grow_buffer_t* buf = &buffers[b];
+        buf->large = b < large_count;
+        buf->lo = buf->large ? large_min : small_min;
+        buf->hi = buf->large ? large_max : small_max;
+        if (restart_buffer(api, buf, pattern) != 0) ok = 0;
+    }
+
+    double copy_bytes_per_ns = large_count > 0 ? memcpy_bytes_per_ns(large_min * 4) : 0;
+
+    syscall_stats_t sys_before, sys_after, sys_delta;
+    syscall_stats_get(&sys_before);
+
+    hr_timer_t timer;
+    size_t total_requested = 0;
+    size_t filler_ops = 0;
+    size_t next_large = 0;
+
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+
+    for (size_t i = 0; ok && i < iterations; i++) {
+        grow_buffer_t* buf;
+        if (large_count > 0 && i % large_every == 0) {
+            buf = &buffers[next_large++ % large_count];
+        } else {
+            buf = &buffers[large_count + xorshift32(&seed) % (buffer_count - large_count)];
+        }
+
+        size_t new_size = next_realloc_size(pattern, buf->size, step);
+        if (new_size > buf->hi || new_size < buf->lo) {
+            if (restart_buffer(api, buf, pattern) != 0) {
+                ok = 0;
+                break;
+            }
+            new_size = next_realloc_size(pattern, buf->size, step);
+        }
+
+        char* old_ptr = buf->ptr;
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        char* new_ptr = api->realloc(old_ptr, new_size);
+        double elapsed = hr_timer_end(&timer);
+
+        if (!new_ptr) {
+            ok = 0;
+            break;
+        }
+
+        realloc_stats_t* stats = buf->large ? &large_stats : &small_stats;
+        latency_recorder_add(&stats->lat, elapsed);
+        stats->time_ns += elapsed;
+        stats->count++;
+        if (new_ptr == old_ptr) {
+            stats->in_place++;
+        } else {
+            size_t moved = new_size < buf->size ? new_size : buf->size;
+            stats->bytes_copied += moved;
+            if (buf->large && copy_bytes_per_ns > 0 &&
+                elapsed < REALLOC_REMAP_COPY_FRACTION * (double)moved / copy_bytes_per_ns) {
+                stats->remapped++;
+            }
+        }
+        if (new_size > buf->size) total_requested += new_size - buf->size;
+
+        fill_tail(new_ptr, buf->size, new_size, buf->large);
+        buf->ptr = new_ptr;
+        buf->size = new_size;
+        series_sampler_add(&sampler, 1);
+
+        /* Neighbours that land next to the buffers and block in-place growth. */
+        for (size_t k = 0; k < interleave; k++) {
+            size_t slot = xorshift32(&seed) % buffer_count;
+            api->free(fillers[slot]);
+            fillers[slot] = api->malloc(size_dist_sample(&dist, &seed));
+            filler_ops += 2;
+        }
+    }
+    series_sampler_finish(&sampler);
+
+    syscall_stats_get(&sys_after);
+    syscall_stats_diff(&sys_delta, &sys_before, &sys_after);
+    memory_stats_sample();
+
+    for (size_t b = 0; buffers && b < buffer_count; b++) {
+        api->free(buffers[b].ptr);
+        api->free(fillers[b]);
+    }
+
+    if (ok) {
+        double total_ns = small_stats.time_ns + large_stats.time_ns;
+        size_t reallocs = small_stats.count + large_stats.count;
+
+        latency_recorder_t all;
+        if (latency_recorder_init(&all, 32768) == 0) {
+            latency_recorder_merge(&all, &small_stats.lat);
+            latency_recorder_merge(&all, &large_stats.lat);
+            result->avg_alloc_time_ns = latency_recorder_mean(&all);
+            result->min_alloc_time_ns = all.min;
+            result->max_alloc_time_ns = all.max;
+            result->p50_alloc_time_ns = latency_recorder_percentile(&all, 0.50);
+            result->p99_alloc_time_ns = latency_recorder_percentile(&all, 0.99);
+            latency_recorder_destroy(&all);
+        }
+
+        result->operations_count = reallocs + filler_ops;
+        result->thread_count = 1;
+        result->realloc_ops_per_sec = (double)reallocs / (total_ns / 1e9);
+        result->alloc_ops_per_sec = result->realloc_ops_per_sec;
+        result->free_ops_per_sec = result->realloc_ops_per_sec;
+        result->total_ops_per_sec = result->realloc_ops_per_sec;
+        result->total_requested_bytes = total_requested;
+        result->total_allocated_bytes = total_requested;
+        result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+        realloc_stats_t combined = small_stats;
+        combined.count += large_stats.count;
+        combined.in_place += large_stats.in_place;
+        combined.bytes_copied += large_stats.bytes_copied;
+        benchmark_result_add_metric(result, "in_place_fraction",
+                                    reallocs ? (double)combined.in_place / reallocs : BENCHMARK_METRIC_NA);
+        benchmark_result_add_metric(result, "bytes_copied_mb", combined.bytes_copied / (1024.0 * 1024.0));
+        report_realloc_stats(result, "small_", &small_stats);
+        report_realloc_stats(result, "large_", &large_stats);
+
+        /* bytes_copied counts what a copying realloc would have moved;
+         * large_remapped is the part of that moved without a copy. */
+        size_t large_moved = large_stats.count - large_stats.in_place;
+        benchmark_result_add_metric(result, "large_remapped", (double)large_stats.remapped);
+        benchmark_result_add_metric(result, "large_copied", (double)(large_moved - large_stats.remapped));
+        benchmark_result_add_metric(result, "large_remap_fraction",
+                                    large_moved ? (double)large_stats.remapped / large_moved : BENCHMARK_METRIC_NA);
+        benchmark_result_add_metric(result, "memcpy_gb_per_sec",
+                                    large_count > 0 ? copy_bytes_per_ns : BENCHMARK_METRIC_NA);
+
+        int counted = syscall_stats_available() && strcmp(api->name, "system") != 0;
+        benchmark_result_add_metric(result, "mmap_calls", counted ? (double)sys_delta.mmap_calls : BENCHMARK_METRIC_NA);
+    }
+
+    latency_recorder_destroy(&small_stats.lat);
+    latency_recorder_destroy(&large_stats.lat);
+    free(buffers);
+    free(fillers);
+    return ok ? 0 : -1;
+}
+
+int bench_realloc_grow_1_5x(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+    return run_realloc_pattern(api, result, cfg, REALLOC_GROW_1_5X);
+}
+
+int bench_realloc_grow_2x(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+    return run_realloc_pattern(api, result, cfg, REALLOC_GROW_2X);
+}
+
+int bench_realloc_grow_step(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+    return run_realloc_pattern(api, result, cfg, REALLOC_GROW_STEP);
+}
+
+int bench_realloc_shrink(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+    return run_realloc_pattern(api, result, cfg, REALLOC_SHRINK);
+}
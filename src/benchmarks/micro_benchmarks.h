@@ -10,5 +10,11 @@ int bench_random_alloc(allocator_api_t* api, benchmark_result_t* result, void* c
 int bench_realloc_benchmark(allocator_api_t* api, benchmark_result_t* result, void* config);
 int bench_aligned_alloc_benchmark(allocator_api_t* api, benchmark_result_t* result, void* config);
 int bench_alloc_free_immediate(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_calloc_small(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_calloc_large(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_realloc_grow_1_5x(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_realloc_grow_2x(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_realloc_grow_step(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_realloc_shrink(allocator_api_t* api, benchmark_result_t* result, void* config);
 
 #endif
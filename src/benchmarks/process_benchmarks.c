@@ -0,0 +1,547 @@
+#include "process_benchmarks.h"
+#include "timer.h"
+#include "memory_stats.h"
+#include "size_dist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#define FORK_MAX_CHILDREN 64
+#define FORK_CHILD_LIVE 256
+
+/* The parent heap is built from request-sized objects, as a prefork server
+ * would have after loading configuration and caches. */
+static benchmark_config_t fork_config = {
+    .iterations = 1000000,
+    .min_size = 16,
+    .max_size = 1024,
+    .thread_count = 1,
+    .seed = 42,
+    .sample_interval_ms = 0,
+    .params = NULL,
+    .size_dist = NULL
+};
+
+/* Sizes for the first allocations in a fresh process: small objects, as a
+ * CLI tool parsing arguments and config would make. */
+static benchmark_config_t cold_config = {
+    .iterations = 1000,
+    .min_size = 16,
+    .max_size = 256,
+    .thread_count = 1,
+    .seed = 42,
+    .sample_interval_ms = 0,
+    .params = NULL,
+    .size_dist = NULL
+};
+
+static unsigned int xorshift32(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+void register_process_benchmarks(void) {
+#ifndef _WIN32
+    static benchmark_t bench1 = {
+        .name = "fork_cow",
+        .description = "Build a heap, fork read-mostly children, measure their private dirty pages",
+        .run = bench_fork_cow,
+        .default_config = &fork_config
+    };
+    benchmark_register(&bench1);
+
+    static benchmark_t bench2 = {
+        .name = "cold_start",
+        .description = "Exec a fresh process per run, time allocator init and first allocations",
+        .run = bench_cold_start,
+        .default_config = &cold_config
+    };
+    benchmark_register(&bench2);
+#endif
+}
+
+#ifndef _WIN32
+
+/* What a child reports back once its work is done. */
+typedef struct {
+    int ok;
+    double start_ns;
+    double work_ns;
+    size_t reads;
+    size_t allocs;
+    size_t frees;
+} fork_child_report_t;
+
+typedef struct {
+    pid_t pid;
+    int report_fd;
+    int release_fd;
+    double fork_ns;
+    fork_child_report_t report;
+    size_t private_dirty_kb;
+} fork_child_t;
+
+typedef struct {
+    size_t reads;
+    size_t alloc_every;
+    double free_parent;
+} fork_work_t;
+
+static size_t smaps_rollup_kb(pid_t pid, const char* field) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/smaps_rollup", (int)pid);
+    FILE* fp = fopen(path, "r");
+    if (!fp) return 0;
+
+    char line[256];
+    size_t len = strlen(field);
+    size_t value = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        if (strncmp(line, field, len) == 0 && line[len] == ':') {
+            sscanf(line + len + 1, "%zu", &value);
+            break;
+        }
+    }
+    fclose(fp);
+    return value;
+}
+
+/* Random reads across the inherited heap, a small allocation every
+ * alloc_every reads (cycled through a short ring), and an occasional free
+ * of an inherited object. */
+static void fork_child_work(allocator_api_t* api, void** objects, size_t* sizes, size_t count,
+                            const fork_work_t* work, unsigned int seed, fork_child_report_t* report) {
+    void* ring[FORK_CHILD_LIVE] = {0};
+    unsigned int free_threshold = (unsigned int)(work->free_parent * 65536.0);
+    uint64_t sum = 0;
+
+    double start = timer_now_ns();
+    for (size_t r = 0; r < work->reads; r++) {
+        size_t i = xorshift32(&seed) % count;
+        if (objects[i]) {
+            const unsigned char* bytes = objects[i];
+            sum += bytes[xorshift32(&seed) % sizes[i]];
+        }
+        report->reads++;
+
+        if (work->alloc_every && r % work->alloc_every == 0) {
+            size_t slot = (r / work->alloc_every) % FORK_CHILD_LIVE;
+            if (ring[slot]) {
+                api->free(ring[slot]);
+                report->frees++;
+            }
+            size_t size = 16 + xorshift32(&seed) % 240;
+            ring[slot] = api->malloc(size);
+            if (!ring[slot]) return;
+            memset(ring[slot], (int)sum, size);
+            report->allocs++;
+
+            if (objects[i] && (xorshift32(&seed) & 0xFFFF) < free_threshold) {
+                api->free(objects[i]);
+                objects[i] = NULL;
+                report->frees++;
+            }
+        }
+    }
+    report->work_ns = timer_now_ns() - start;
+
+    for (size_t s = 0; s < FORK_CHILD_LIVE; s++) {
+        if (ring[s]) api->free(ring[s]);
+    }
+    benchmark_do_not_optimize(sum);
+    report->ok = 1;
+}
+
+/* Forks one child and returns once it has reported; the child then blocks
+ * until release_fd is closed so its smaps can be read while it is alive. */
+static int fork_child_spawn(allocator_api_t* api, void** objects, size_t* sizes, size_t count,
+                            const fork_work_t* work, unsigned int seed, fork_child_t* child) {
+    int report_pipe[2], release_pipe[2];
+    if (pipe(report_pipe) != 0) return -1;
+    if (pipe(release_pipe) != 0) {
+        close(report_pipe[0]);
+        close(report_pipe[1]);
+        return -1;
+    }
+
+    fflush(stdout);
+    double before = timer_now_ns();
+    pid_t pid = fork();
+    if (pid == 0) {
+        fork_child_report_t report;
+        memset(&report, 0, sizeof(report));
+        report.start_ns = timer_now_ns() - before;
+
+        close(report_pipe[0]);
+        close(release_pipe[1]);
+        if (work) {
+            fork_child_work(api, objects, sizes, count, work, seed, &report);
+        } else {
+            report.ok = 1;
+        }
+
+        ssize_t written = write(report_pipe[1], &report, sizeof(report));
+        char byte;
+        while (read(release_pipe[0], &byte, 1) > 0) {}
+        _exit(written == (ssize_t)sizeof(report) ? 0 : 1);
+    }
+    child->fork_ns = timer_now_ns() - before;
+
+    close(report_pipe[1]);
+    close(release_pipe[0]);
+    if (pid < 0) {
+        close(report_pipe[0]);
+        close(release_pipe[1]);
+        return -1;
+    }
+
+    child->pid = pid;
+    child->report_fd = report_pipe[0];
+    child->release_fd = release_pipe[1];
+    return 0;
+}
+
+static void fork_child_collect(fork_child_t* child) {
+    memset(&child->report, 0, sizeof(child->report));
+    if (read(child->report_fd, &child->report, sizeof(child->report)) != (ssize_t)sizeof(child->report)) {
+        child->report.ok = 0;
+    }
+    child->private_dirty_kb = smaps_rollup_kb(child->pid, "Private_Dirty");
+
+    close(child->report_fd);
+}
+
+/* Later children inherit the release pipes of earlier ones, so every pipe
+ * must be closed before waiting on any child. */
+static void fork_children_release(fork_child_t* kids, int count) {
+    for (int c = 0; c < count; c++) close(kids[c].release_fd);
+    for (int c = 0; c < count; c++) waitpid(kids[c].pid, NULL, 0);
+}
+
+int bench_fork_cow(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &fork_config;
+
+    size_t heap_bytes = benchmark_param_size(cfg, "heap_mb", 128) * 1024 * 1024;
+    int children = (int)benchmark_param_size(cfg, "children", 4);
+    fork_work_t work = {
+        .reads = benchmark_param_size(cfg, "reads", cfg->iterations),
+        .alloc_every = benchmark_param_size(cfg, "alloc_every", 100),
+        .free_parent = benchmark_param_double(cfg, "free_parent", 0.01)
+    };
+    if (children < 1) children = 1;
+    if (children > FORK_MAX_CHILDREN) children = FORK_MAX_CHILDREN;
+
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
+    unsigned int seed = cfg->seed;
+
+    size_t capacity = heap_bytes / (dist.min_size ? dist.min_size : 1) + 1;
+    void** objects = malloc(capacity * sizeof(void*));
+    size_t* sizes = malloc(capacity * sizeof(size_t));
+    fork_child_t* kids = calloc(children + 1, sizeof(fork_child_t));
+    if (!objects || !sizes || !kids) {
+        free(objects);
+        free(sizes);
+        free(kids);
+        return -1;
+    }
+
+    size_t count = 0, requested = 0;
+    int ok = 1;
+    while (requested < heap_bytes && count < capacity) {
+        size_t size = size_dist_sample(&dist, &seed);
+        objects[count] = api->malloc(size);
+        if (!objects[count]) {
+            ok = 0;
+            break;
+        }
+        memset(objects[count], (int)count, size);
+        sizes[count] = size;
+        requested += size;
+        count++;
+    }
+    memory_stats_sample();
+
+    /* A child that does nothing shows what fork alone dirties (stack, libc
+     * and allocator globals); the workers are reported on top of it. */
+    fork_child_t* idle = &kids[children];
+    size_t baseline_dirty_kb = 0;
+    if (ok && fork_child_spawn(api, objects, sizes, count, NULL, 0, idle) == 0) {
+        fork_child_collect(idle);
+        fork_children_release(idle, 1);
+        baseline_dirty_kb = idle->private_dirty_kb;
+    } else {
+        ok = 0;
+    }
+
+    int spawned = 0;
+    for (int c = 0; ok && c < children; c++) {
+        if (fork_child_spawn(api, objects, sizes, count, &work, cfg->seed + c * 7919, &kids[c]) != 0) {
+            ok = 0;
+            break;
+        }
+        spawned++;
+    }
+    for (int c = 0; c < spawned; c++) {
+        fork_child_collect(&kids[c]);
+        if (!kids[c].report.ok) ok = 0;
+    }
+    fork_children_release(kids, spawned);
+
+    for (size_t i = 0; i < count; i++) api->free(objects[i]);
+    free(objects);
+    free(sizes);
+
+    if (ok) {
+        double fork_sum = 0, fork_max = 0, start_sum = 0, work_ns = 0;
+        double dirty_sum = 0, dirty_max = 0;
+        size_t reads = 0, allocs = 0, frees = 0;
+        for (int c = 0; c < children; c++) {
+            fork_child_t* kid = &kids[c];
+            double dirty = kid->private_dirty_kb > baseline_dirty_kb
+                               ? (double)(kid->private_dirty_kb - baseline_dirty_kb) : 0.0;
+            fork_sum += kid->fork_ns;
+            if (kid->fork_ns > fork_max) fork_max = kid->fork_ns;
+            start_sum += kid->report.start_ns;
+            work_ns += kid->report.work_ns;
+            dirty_sum += dirty;
+            if (dirty > dirty_max) dirty_max = dirty;
+            reads += kid->report.reads;
+            allocs += kid->report.allocs;
+            frees += kid->report.frees;
+        }
+
+        result->operations_count = allocs + frees;
+        result->thread_count = children;
+        result->alloc_ops_per_sec = (double)allocs / (work_ns / 1e9);
+        result->free_ops_per_sec = (double)frees / (work_ns / 1e9);
+        result->total_ops_per_sec = (double)reads / (work_ns / 1e9);
+        result->avg_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->total_requested_bytes = requested;
+        result->total_allocated_bytes = requested;
+        result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+        benchmark_result_add_metric(result, "children", (double)children);
+        benchmark_result_add_metric(result, "heap_kb", (double)requested / 1024.0);
+        benchmark_result_add_metric(result, "heap_objects", (double)count);
+        benchmark_result_add_metric(result, "fork_us_avg", fork_sum / children / 1e3);
+        benchmark_result_add_metric(result, "fork_us_max", fork_max / 1e3);
+        benchmark_result_add_metric(result, "child_start_us_avg", start_sum / children / 1e3);
+        benchmark_result_add_metric(result, "idle_child_dirty_kb", (double)baseline_dirty_kb);
+        benchmark_result_add_metric(result, "child_dirty_kb_avg", dirty_sum / children);
+        benchmark_result_add_metric(result, "child_dirty_kb_max", dirty_max);
+        benchmark_result_add_metric(result, "child_dirty_fraction", dirty_sum / children * 1024.0 / (double)requested);
+        benchmark_result_add_metric(result, "child_work_ms_avg", work_ns / children / 1e6);
+    }
+
+    free(kids);
+
+    return ok ? 0 : -1;
+}
+
+/* What one allocbench_coldstart run reports; times are from just before
+ * execv in the parent. */
+typedef struct {
+    double main_ns;
+    double first_ns;
+    double last_ns;
+    long faults;
+    size_t count;               /* blocks the child actually allocated */
+    size_t rss_kb;
+    size_t private_dirty_kb;
+} cold_report_t;
+
+/* allocbench_coldstart_<allocator> next to this binary; "none" is the bare one. */
+static int coldstart_path(char* path, size_t size, const char* allocator) {
+    ssize_t len = readlink("/proc/self/exe", path, size - 1);
+    if (len <= 0) return -1;
+    path[len] = '\0';
+
+    char* slash = strrchr(path, '/');
+    if (!slash) return -1;
+    size_t room = size - (size_t)(slash + 1 - path);
+    int written = snprintf(slash + 1, room, "allocbench_coldstart_%s", allocator);
+    if (written < 0 || (size_t)written >= room) return -1;
+    return access(path, X_OK);
+}
+
+/* Execs the cold-start binary, reads its report and, while it sits idle
+ * waiting on stdin, its resident and private dirty footprint. */
+static int cold_run(const char* path, size_t count,
+                    size_t min_size, size_t max_size, cold_report_t* report) {
+    char count_arg[32], min_arg[32], max_arg[32], exec_arg[32];
+    snprintf(count_arg, sizeof(count_arg), "%zu", count);
+    snprintf(min_arg, sizeof(min_arg), "%zu", min_size);
+    snprintf(max_arg, sizeof(max_arg), "%zu", max_size);
+
+    int report_pipe[2], release_pipe[2];
+    if (pipe(report_pipe) != 0) return -1;
+    if (pipe(release_pipe) != 0) {
+        close(report_pipe[0]);
+        close(report_pipe[1]);
+        return -1;
+    }
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        dup2(report_pipe[1], STDOUT_FILENO);
+        dup2(release_pipe[0], STDIN_FILENO);
+        close(report_pipe[0]);
+        close(report_pipe[1]);
+        close(release_pipe[0]);
+        close(release_pipe[1]);
+
+        char* args[] = {(char*)path, count_arg, min_arg, max_arg, exec_arg, NULL};
+        snprintf(exec_arg, sizeof(exec_arg), "%.0f", timer_now_ns());
+        execv(path, args);
+        _exit(127);
+    }
+
+    close(report_pipe[1]);
+    close(release_pipe[0]);
+    if (pid < 0) {
+        close(report_pipe[0]);
+        close(release_pipe[1]);
+        return -1;
+    }
+
+    char line[256];
+    size_t len = 0;
+    while (len < sizeof(line) - 1) {
+        ssize_t n = read(report_pipe[0], line + len, sizeof(line) - 1 - len);
+        if (n <= 0) break;
+        len += (size_t)n;
+        if (line[len - 1] == '\n') break;
+    }
+    line[len] = '\0';
+
+    memset(report, 0, sizeof(*report));
+    int ok = sscanf(line, "%lf %lf %lf %ld %zu", &report->main_ns, &report->first_ns,
+                    &report->last_ns, &report->faults, &report->count) == 5;
+    if (ok) {
+        report->rss_kb = smaps_rollup_kb(pid, "Rss");
+        report->private_dirty_kb = smaps_rollup_kb(pid, "Private_Dirty");
+    }
+
+    close(report_pipe[0]);
+    close(release_pipe[1]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return ok && WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : -1;
+}
+
+/* Every allocator in the harness is initialized and warm long before any
+ * benchmark runs, which hides what short-lived processes pay most: allocator
+ * setup and the first allocations. Each run here is a fresh exec; a bare run
+ * that never allocates is interleaved as the per-process baseline. */
+int bench_cold_start(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &cold_config;
+
+    size_t runs = benchmark_param_size(cfg, "runs", 20);
+    size_t count = benchmark_param_size(cfg, "count", cfg->iterations);
+    if (runs < 1) runs = 1;
+    if (count < 1) count = 1;
+
+    char path[4096], bare_path[4096];
+    if (!api->name || coldstart_path(path, sizeof(path), api->name) != 0) {
+        fprintf(stderr, "cold_start: allocbench_coldstart_%s not found next to this binary\n",
+                api->name ? api->name : "?");
+        return -1;
+    }
+    if (coldstart_path(bare_path, sizeof(bare_path), "none") != 0) {
+        fprintf(stderr, "cold_start: allocbench_coldstart_none not found next to this binary\n");
+        return -1;
+    }
+
+    double main_sum = 0, first_sum = 0, first_max = 0, init_sum = 0, last_sum = 0, phase_sum = 0;
+    double faults_sum = 0, rss_sum = 0, dirty_sum = 0;
+    size_t allocated = 0;
+    double bare_main_sum = 0, bare_rss_sum = 0, bare_dirty_sum = 0;
+
+    for (size_t r = 0; r < runs; r++) {
+        cold_report_t bare, cold;
+        if (cold_run(bare_path, count, cfg->min_size, cfg->max_size, &bare) != 0) return -1;
+        if (cold_run(path, count, cfg->min_size, cfg->max_size, &cold) != 0) return -1;
+
+        bare_main_sum += bare.main_ns;
+        bare_rss_sum += (double)bare.rss_kb;
+        bare_dirty_sum += (double)bare.private_dirty_kb;
+
+        main_sum += cold.main_ns;
+        first_sum += cold.first_ns;
+        if (cold.first_ns > first_max) first_max = cold.first_ns;
+        init_sum += cold.first_ns - cold.main_ns;
+        last_sum += cold.last_ns;
+        phase_sum += cold.last_ns - cold.main_ns;
+        faults_sum += (double)cold.faults;
+        allocated += cold.count;
+        rss_sum += (double)cold.rss_kb;
+        dirty_sum += (double)cold.private_dirty_kb;
+    }
+
+    double n = (double)runs;
+    /* The child caps count, so rates use what it reports having allocated. */
+    result->operations_count = allocated;
+    result->thread_count = 1;
+    result->alloc_ops_per_sec = (double)allocated / (phase_sum / 1e9);
+    result->free_ops_per_sec = 0;
+    result->total_ops_per_sec = result->alloc_ops_per_sec;
+    result->avg_alloc_time_ns = phase_sum / (double)allocated;
+    result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+    benchmark_result_add_metric(result, "runs", n);
+    benchmark_result_add_metric(result, "count", (double)allocated / n);
+    benchmark_result_add_metric(result, "exec_to_main_us", main_sum / n / 1e3);
+    benchmark_result_add_metric(result, "first_malloc_us", first_sum / n / 1e3);
+    benchmark_result_add_metric(result, "first_malloc_us_max", first_max / 1e3);
+    benchmark_result_add_metric(result, "init_first_malloc_us", init_sum / n / 1e3);
+    benchmark_result_add_metric(result, "first_n_us", last_sum / n / 1e3);
+    benchmark_result_add_metric(result, "first_n_alloc_us", phase_sum / n / 1e3);
+    benchmark_result_add_metric(result, "first_n_faults", faults_sum / n);
+    benchmark_result_add_metric(result, "idle_rss_kb", rss_sum / n);
+    benchmark_result_add_metric(result, "idle_dirty_kb", dirty_sum / n);
+    benchmark_result_add_metric(result, "bare_exec_to_main_us", bare_main_sum / n / 1e3);
+    benchmark_result_add_metric(result, "bare_rss_kb", bare_rss_sum / n);
+    benchmark_result_add_metric(result, "bare_dirty_kb", bare_dirty_sum / n);
+    benchmark_result_add_metric(result, "rss_over_bare_kb", (rss_sum - bare_rss_sum) / n);
+    benchmark_result_add_metric(result, "dirty_over_bare_kb", (dirty_sum - bare_dirty_sum) / n);
+
+    return 0;
+}
+
+#else
+
+int bench_fork_cow(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    (void)api;
+    (void)result;
+    (void)config;
+    return -1;
+}
+
+int bench_cold_start(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    (void)api;
+    (void)result;
+    (void)config;
+    return -1;
+}
+
+#endif
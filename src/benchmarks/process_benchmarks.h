@@ -0,0 +1,11 @@
+#ifndef PROCESS_BENCHMARKS_H
+#define PROCESS_BENCHMARKS_H
+
+#include "../benchmark.h"
+
+void register_process_benchmarks(void);
+
+int bench_fork_cow(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_cold_start(allocator_api_t* api, benchmark_result_t* result, void* config);
+
+#endif
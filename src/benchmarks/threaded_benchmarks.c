@@ -1,32 +1,34 @@
 #include "threaded_benchmarks.h"
 #include "timer.h"
 #include "memory_stats.h"
+#include "timeseries.h"
+#include "latency.h"
+#include "threading.h"
+#include "size_dist.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
 
-#if defined(_WIN32) || defined(_WIN64)
-#include <windows.h>
-#define THREAD_TYPE HANDLE
-#define THREAD_FUNC DWORD WINAPI
-#define THREAD_ARG LPVOID
-#define THREAD_RETURN DWORD
-#define thread_create(thread, func, arg) (*(thread) = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)(func), (arg), 0, NULL))
-#define thread_join(thread) WaitForSingleObject((thread), INFINITE)
-#define thread_return() return 0
-#else
-#include <pthread.h>
-#define THREAD_TYPE pthread_t
-#define THREAD_FUNC void*
-#define THREAD_ARG void*
-#define THREAD_RETURN void*
-#define thread_create(thread, func, arg) pthread_create((thread), NULL, (func), (arg))
-#define thread_join(thread) pthread_join((thread), NULL)
-#define thread_return() return NULL
-#endif
+#define CACHE_LINE_SIZE 64
+#define LATENCY_SAMPLES_PER_THREAD 100000
 
 static benchmark_config_t default_config = BENCHMARK_DEFAULT_CONFIG;
 
+/* Up to a third of parallel_stress objects are 64 KB+, which most allocators
+ * serve straight from mmap, so it runs fewer operations by default. */
+static benchmark_config_t stress_config = {
+    .iterations = 200000,
+    .min_size = 8,
+    .max_size = 1024 * 1024,
+    .thread_count = 4,
+    .seed = 42,
+    .sample_interval_ms = 0,
+    .params = NULL,
+    .size_dist = NULL
+};
+
 static unsigned int xorshift32(unsigned int* state) {
     unsigned int x = *state;
     x ^= x << 13;
@@ -36,19 +38,19 @@ static unsigned int xorshift32(unsigned int* state) {
     return x;
 }
 
-static size_t random_size(unsigned int* state, size_t min_size, size_t max_size) {
-    return min_size + (xorshift32(state) % (max_size - min_size + 1));
-}
-
 typedef struct {
     allocator_api_t* api;
     size_t iterations;
-    size_t min_size;
-    size_t max_size;
+    const size_dist_t* dist;
     unsigned int seed;
+    double sample_interval_ms;
+    start_barrier_t* start_barrier;
+    double start_ns;
+    double end_ns;
     double total_time_ns;
     size_t alloc_count;
     size_t free_count;
+    benchmark_series_t series;
 } thread_args_t;
 
 static THREAD_FUNC thread_alloc_func(THREAD_ARG arg) {
@@ -62,17 +64,30 @@ static THREAD_FUNC thread_alloc_func(THREAD_ARG arg) {
 
     size_t batch_size = args->iterations / 10;
     void** ptrs = malloc(batch_size * sizeof(void*));
-    if (!ptrs) thread_return();
+
+    if (!start_barrier_wait(args->start_barrier)) {
+        free(ptrs);
+        thread_return();
+    }
+    args->start_ns = timer_now_ns();
+    if (!ptrs) {
+        args->end_ns = args->start_ns;
+        thread_return();
+    }
+
+    series_sampler_t sampler;
+    series_sampler_init_at(&sampler, &args->series, args->sample_interval_ms, args->start_ns);
 
     for (size_t batch = 0; batch < 10; batch++) {
         for (size_t i = 0; i < batch_size; i++) {
-            size_t size = random_size(&args->seed, args->min_size, args->max_size);
+            size_t size = size_dist_sample(args->dist, &args->seed);
 
             hr_timer_init(&timer);
             hr_timer_start(&timer);
             ptrs[i] = api->malloc(size);
             total_time += hr_timer_end(&timer);
             allocs++;
+            series_sampler_add(&sampler, 1);
         }
 
         for (size_t i = 0; i < batch_size; i++) {
@@ -82,9 +97,12 @@ static THREAD_FUNC thread_alloc_func(THREAD_ARG arg) {
                 api->free(ptrs[i]);
                 total_time += hr_timer_end(&timer);
                 frees++;
+                series_sampler_add(&sampler, 1);
             }
         }
     }
+    args->end_ns = timer_now_ns();
+    series_sampler_finish(&sampler);
 
     args->total_time_ns = total_time;
     args->alloc_count = allocs;
@@ -95,92 +113,123 @@ static THREAD_FUNC thread_alloc_func(THREAD_ARG arg) {
 }
 
 void register_threaded_benchmarks(void) {
-    static benchmark_t bench1 = {
-        .name = "threaded_alloc_1",
-        .description = "Threaded allocation test (1 thread)",
-        .run = bench_threaded_alloc,
+    benchmark_register_thread_sweep("threaded_alloc", "Threaded allocation test",
+                                    bench_threaded_alloc, 4);
+
+    static benchmark_t bench_pc = {
+        .name = "producer_consumer",
+        .description = "Producers allocate, consumers free via MPMC ring",
+        .run = bench_producer_consumer,
         .default_config = &default_config
     };
-    benchmark_register(&bench1);
+    benchmark_register(&bench_pc);
 
-    static benchmark_t bench2 = {
-        .name = "threaded_alloc_2",
-        .description = "Threaded allocation test (2 threads)",
-        .run = bench_threaded_alloc_2,
-        .default_config = &default_config
+    static benchmark_t bench_stress = {
+        .name = "parallel_stress",
+        .description = "Mixed malloc/calloc/realloc/aligned/free with cross-thread handoff",
+        .run = bench_parallel_stress,
+        .default_config = &stress_config
     };
-    benchmark_register(&bench2);
+    benchmark_register(&bench_stress);
 
-    static benchmark_t bench3 = {
-        .name = "threaded_alloc_4",
-        .description = "Threaded allocation test (4 threads)",
-        .run = bench_threaded_alloc_4,
+    static benchmark_t bench_churn = {
+        .name = "thread_churn",
+        .description = "Short-lived threads: thread-cache setup and teardown cost",
+        .run = bench_thread_churn,
         .default_config = &default_config
     };
-    benchmark_register(&bench3);
+    benchmark_register(&bench_churn);
 
-    static benchmark_t bench4 = {
-        .name = "threaded_alloc_8",
-        .description = "Threaded allocation test (8 threads)",
-        .run = bench_threaded_alloc_8,
+    static benchmark_t bench_logger = {
+        .name = "logger_mpsc",
+        .description = "Many producers format log lines, one writer frees them",
+        .run = bench_logger_mpsc,
         .default_config = &default_config
     };
-    benchmark_register(&bench4);
+    benchmark_register(&bench_logger);
 
-    static benchmark_t bench5 = {
-        .name = "threaded_alloc_16",
-        .description = "Threaded allocation test (16 threads)",
-        .run = bench_threaded_alloc_16,
+    static benchmark_t bench_sharing = {
+        .name = "false_sharing",
+        .description = "Concurrent small allocations updated in place; cache-line sharing",
+        .run = bench_false_sharing,
         .default_config = &default_config
     };
-    benchmark_register(&bench5);
+    benchmark_register(&bench_sharing);
 }
 
 static int run_threaded(allocator_api_t* api, benchmark_result_t* result,
                         benchmark_config_t* cfg, int thread_count) {
 
-    if (thread_count > MAX_THREADS) thread_count = MAX_THREADS;
+    if (thread_count < 1) thread_count = 1;
+
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
 
-    THREAD_TYPE threads[MAX_THREADS];
-    thread_args_t args[MAX_THREADS];
+    THREAD_TYPE* threads = malloc(thread_count * sizeof(THREAD_TYPE));
+    thread_args_t* args = calloc(thread_count, sizeof(thread_args_t));
+    if (!threads || !args) {
+        free(threads);
+        free(args);
+        return -1;
+    }
+
+    start_barrier_t start_barrier;
+    start_barrier_init(&start_barrier);
 
     size_t iterations_per_thread = cfg->iterations / thread_count;
 
     for (int i = 0; i < thread_count; i++) {
         args[i].api = api;
         args[i].iterations = iterations_per_thread;
-        args[i].min_size = cfg->min_size;
-        args[i].max_size = cfg->max_size;
+        args[i].dist = &dist;
         args[i].seed = cfg->seed + i * 12345;
-        args[i].total_time_ns = 0;
-        args[i].alloc_count = 0;
-        args[i].free_count = 0;
+        args[i].sample_interval_ms = cfg->sample_interval_ms;
+        args[i].start_barrier = &start_barrier;
     }
 
-    hr_timer_t total_timer;
-    hr_timer_init(&total_timer);
-    hr_timer_start(&total_timer);
-
-    for (int i = 0; i < thread_count; i++) {
-        thread_create(&threads[i], thread_alloc_func, &args[i]);
+    int started = 0;
+    while (started < thread_count &&
+           thread_create(&threads[started], thread_alloc_func, &args[started]) == 0) {
+        started++;
+    }
+    if (started < thread_count) {
+        start_barrier_abort(&start_barrier);
+        for (int i = 0; i < started; i++) thread_join(threads[i]);
+        start_barrier_destroy(&start_barrier);
+        free(threads);
+        free(args);
+        return -1;
     }
 
+    /* Every worker is spawned and parked on the barrier before the clock starts. */
+    start_barrier_release(&start_barrier, started);
+
     for (int i = 0; i < thread_count; i++) {
         thread_join(threads[i]);
     }
 
-    double total_time_ns = hr_timer_end(&total_timer);
+    start_barrier_destroy(&start_barrier);
 
+    double first_start_ns = args[0].start_ns;
+    double last_end_ns = args[0].end_ns;
     double total_ops_time = 0;
     size_t total_allocs = 0;
     size_t total_frees = 0;
 
     for (int i = 0; i < thread_count; i++) {
+        if (args[i].start_ns < first_start_ns) first_start_ns = args[i].start_ns;
+        if (args[i].end_ns > last_end_ns) last_end_ns = args[i].end_ns;
         total_ops_time += args[i].total_time_ns;
         total_allocs += args[i].alloc_count;
         total_frees += args[i].free_count;
+        series_merge(&result->throughput_series, &args[i].series);
     }
 
+    double total_time_ns = last_end_ns - first_start_ns;
+
+    free(threads);
+    free(args);
+
     result->operations_count = total_allocs + total_frees;
     result->thread_count = thread_count;
     result->alloc_ops_per_sec = (double)total_allocs / (total_time_ns / 1e9);
@@ -192,7 +241,7 @@ static int run_threaded(allocator_api_t* api, benchmark_result_t* result,
     result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
     result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
     result->total_time_ms = total_time_ns / 1e6;
-    result->total_requested_bytes = total_allocs * ((cfg->min_size + cfg->max_size) / 2);
+    result->total_requested_bytes = (size_t)(total_allocs * dist.mean_size);
     result->total_allocated_bytes = result->total_requested_bytes;
     result->fragmentation_ratio = BENCHMARK_METRIC_NA;
 
@@ -201,59 +250,1368 @@ static int run_threaded(allocator_api_t* api, benchmark_result_t* result,
 
 int bench_threaded_alloc(allocator_api_t* api, benchmark_result_t* result, void* config) {
     benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
-    return run_threaded(api, result, cfg, 1);
+    return run_threaded(api, result, cfg, cfg->thread_count);
 }
 
-int bench_threaded_alloc_2(allocator_api_t* api, benchmark_result_t* result, void* config) {
-    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
-    return run_threaded(api, result, cfg, 2);
+/* Bounded lock-free MPMC ring (Vyukov). With one producer and one consumer it
+ * degenerates to an SPSC queue with the same memory ordering. */
+typedef struct {
+    atomic_size_t sequence;
+    void* data;
+} ring_cell_t;
+
+typedef struct {
+    ring_cell_t* cells;
+    size_t mask;
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t enqueue_pos;
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t dequeue_pos;
+} mpmc_ring_t;
+
+static int ring_init(mpmc_ring_t* ring, size_t depth) {
+    size_t capacity = 2;
+    while (capacity < depth) capacity <<= 1;
+
+    ring->cells = malloc(capacity * sizeof(ring_cell_t));
+    if (!ring->cells) return -1;
+
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&ring->cells[i].sequence, i);
+        ring->cells[i].data = NULL;
+    }
+    ring->mask = capacity - 1;
+    atomic_init(&ring->enqueue_pos, 0);
+    atomic_init(&ring->dequeue_pos, 0);
+    return 0;
 }
 
-int bench_threaded_alloc_4(allocator_api_t* api, benchmark_result_t* result, void* config) {
-    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
-    return run_threaded(api, result, cfg, 4);
+static void ring_destroy(mpmc_ring_t* ring) {
+    free(ring->cells);
+    ring->cells = NULL;
 }
 
-int bench_threaded_alloc_8(allocator_api_t* api, benchmark_result_t* result, void* config) {
-    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
-    return run_threaded(api, result, cfg, 8);
+static int ring_try_push(mpmc_ring_t* ring, void* data) {
+    size_t pos = atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed);
+    for (;;) {
+        ring_cell_t* cell = &ring->cells[pos & ring->mask];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                cell->data = data;
+                atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = atomic_load_explicit(&ring->enqueue_pos, memory_order_relaxed);
+        }
+    }
 }
 
-int bench_threaded_alloc_16(allocator_api_t* api, benchmark_result_t* result, void* config) {
-    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
-    return run_threaded(api, result, cfg, 16);
+static void* ring_try_pop(mpmc_ring_t* ring) {
+    size_t pos = atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed);
+    for (;;) {
+        ring_cell_t* cell = &ring->cells[pos & ring->mask];
+        size_t seq = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                void* data = cell->data;
+                atomic_store_explicit(&cell->sequence, pos + ring->mask + 1, memory_order_release);
+                return data;
+            }
+        } else if (diff < 0) {
+            return NULL;
+        } else {
+            pos = atomic_load_explicit(&ring->dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+/* Pushed in place of a message when malloc fails, so consumer counts still match. */
+static char alloc_failed_marker;
+
+typedef struct {
+    allocator_api_t* api;
+    mpmc_ring_t* ring;
+    start_barrier_t* start_barrier;
+    atomic_llong* unclaimed;
+    atomic_int* finished;
+    size_t messages;
+    const size_dist_t* dist;
+    unsigned int seed;
+    latency_recorder_t latency;
+    size_t bytes;
+    size_t count;
+    size_t failures;
+    double start_ns;
+    double end_ns;
+} pc_thread_args_t;
+
+static THREAD_FUNC producer_func(THREAD_ARG arg) {
+    pc_thread_args_t* args = (pc_thread_args_t*)arg;
+    allocator_api_t* api = args->api;
+    hr_timer_t timer;
+
+    if (!start_barrier_wait(args->start_barrier)) thread_return();
+    args->start_ns = timer_now_ns();
+
+    for (size_t i = 0; i < args->messages; i++) {
+        size_t size = size_dist_sample(args->dist, &args->seed);
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        void* msg = api->malloc(size);
+        latency_recorder_add(&args->latency, hr_timer_end(&timer));
+
+        if (msg) {
+            memset(msg, (int)i, size < CACHE_LINE_SIZE ? size : CACHE_LINE_SIZE);
+            args->bytes += size;
+            args->count++;
+        } else {
+            msg = &alloc_failed_marker;
+            args->failures++;
+        }
+
+        while (!ring_try_push(args->ring, msg)) {
+            thread_yield();
+        }
+    }
+
+    args->end_ns = timer_now_ns();
+    atomic_fetch_add(args->finished, 1);
+    thread_return();
+}
+
+static THREAD_FUNC consumer_func(THREAD_ARG arg) {
+    pc_thread_args_t* args = (pc_thread_args_t*)arg;
+    allocator_api_t* api = args->api;
+    hr_timer_t timer;
+
+    if (!start_barrier_wait(args->start_barrier)) thread_return();
+    args->start_ns = timer_now_ns();
+
+    /* Claim a message before popping so consumers never wait on one that is never sent. */
+    while (atomic_fetch_sub_explicit(args->unclaimed, 1, memory_order_relaxed) > 0) {
+        void* msg;
+        while (!(msg = ring_try_pop(args->ring))) {
+            thread_yield();
+        }
+        if (msg == &alloc_failed_marker) continue;
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        api->free(msg);
+        latency_recorder_add(&args->latency, hr_timer_end(&timer));
+        args->count++;
+    }
+
+    args->end_ns = timer_now_ns();
+    atomic_fetch_add(args->finished, 1);
+    thread_return();
 }
 
 int bench_producer_consumer(allocator_api_t* api, benchmark_result_t* result, void* config) {
     benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
 
-    result->operations_count = cfg->iterations;
-    result->thread_count = 2;
-    result->alloc_ops_per_sec = cfg->iterations / 0.001;
-    result->total_ops_per_sec = result->alloc_ops_per_sec;
-    result->avg_alloc_time_ns = 1000.0;
-    result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
-    result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
-    result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
-    result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+    int producers = (int)benchmark_param_size(cfg, "producers", 2);
+    int consumers = (int)benchmark_param_size(cfg, "consumers", 2);
+    size_t queue_depth = benchmark_param_size(cfg, "queue_depth", 1024);
+    size_t min_size = benchmark_param_size(cfg, "msg_min", cfg->min_size);
+    size_t max_size = benchmark_param_size(cfg, "msg_max", cfg->max_size);
+    if (producers < 1) producers = 1;
+    if (consumers < 1) consumers = 1;
+    if (max_size < min_size) max_size = min_size;
+
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, min_size, max_size) != 0) return -1;
+
+    int thread_count = producers + consumers;
+    size_t total_messages = (cfg->iterations / producers) * producers;
+
+    mpmc_ring_t ring;
+    if (ring_init(&ring, queue_depth) != 0) return -1;
+
+    THREAD_TYPE* threads = malloc(thread_count * sizeof(THREAD_TYPE));
+    pc_thread_args_t* args = calloc(thread_count, sizeof(pc_thread_args_t));
+    if (!threads || !args) {
+        free(threads);
+        free(args);
+        ring_destroy(&ring);
+        return -1;
+    }
+
+    start_barrier_t start_barrier;
+    start_barrier_init(&start_barrier);
+    atomic_llong unclaimed;
+    atomic_int finished;
+    atomic_init(&unclaimed, (long long)total_messages);
+    atomic_init(&finished, 0);
+
+    int ok = 1;
+    for (int i = 0; i < thread_count; i++) {
+        args[i].api = api;
+        args[i].ring = &ring;
+        args[i].start_barrier = &start_barrier;
+        args[i].unclaimed = &unclaimed;
+        args[i].finished = &finished;
+        args[i].messages = total_messages / producers;
+        args[i].dist = &dist;
+        args[i].seed = cfg->seed + i * 12345;
+        if (latency_recorder_init(&args[i].latency, LATENCY_SAMPLES_PER_THREAD) != 0) ok = 0;
+    }
+
+    size_t rss_start_kb = memory_stats_sample();
+    size_t rss_peak_kb = rss_start_kb;
+
+    int started = 0;
+    while (ok && started < thread_count &&
+           thread_create(&threads[started], started < producers ? producer_func : consumer_func,
+                         &args[started]) == 0) {
+        started++;
+    }
+    if (started < thread_count) {
+        start_barrier_abort(&start_barrier);
+        for (int i = 0; i < started; i++) thread_join(threads[i]);
+        ok = 0;
+    }
+
+    if (ok) {
+        start_barrier_release(&start_barrier, started);
+
+        /* Remote frees that the allocator defers show up as RSS above the in-flight set. */
+        while (atomic_load(&finished) < thread_count) {
+            size_t rss = memory_stats_sample();
+            if (rss > rss_peak_kb) rss_peak_kb = rss;
+            thread_sleep_us(1000);
+        }
+
+        for (int i = 0; i < thread_count; i++) {
+            thread_join(threads[i]);
+        }
+    }
+
+    start_barrier_destroy(&start_barrier);
+    size_t rss_end_kb = memory_stats_sample();
+    if (rss_end_kb > rss_peak_kb) rss_peak_kb = rss_end_kb;
+
+    latency_recorder_t alloc_latency, free_latency;
+    latency_recorder_init(&alloc_latency, LATENCY_SAMPLES_PER_THREAD);
+    latency_recorder_init(&free_latency, LATENCY_SAMPLES_PER_THREAD);
+
+    double first_start_ns = args[0].start_ns;
+    double last_end_ns = args[0].end_ns;
+    size_t produced = 0, consumed = 0, failures = 0, bytes = 0;
+
+    for (int i = 0; i < thread_count; i++) {
+        if (args[i].start_ns < first_start_ns) first_start_ns = args[i].start_ns;
+        if (args[i].end_ns > last_end_ns) last_end_ns = args[i].end_ns;
+        if (i < producers) {
+            latency_recorder_merge(&alloc_latency, &args[i].latency);
+            produced += args[i].count;
+            failures += args[i].failures;
+            bytes += args[i].bytes;
+        } else {
+            latency_recorder_merge(&free_latency, &args[i].latency);
+            consumed += args[i].count;
+        }
+        latency_recorder_destroy(&args[i].latency);
+    }
+
+    free(threads);
+    free(args);
+    ring_destroy(&ring);
+
+    if (!ok || failures > 0) {
+        latency_recorder_destroy(&alloc_latency);
+        latency_recorder_destroy(&free_latency);
+        return -1;
+    }
+
+    double total_time_ns = last_end_ns - first_start_ns;
+
+    result->operations_count = produced + consumed;
+    result->thread_count = thread_count;
+    result->alloc_ops_per_sec = (double)produced / (total_time_ns / 1e9);
+    result->free_ops_per_sec = (double)consumed / (total_time_ns / 1e9);
+    result->total_ops_per_sec = (double)result->operations_count / (total_time_ns / 1e9);
+    result->avg_alloc_time_ns = latency_recorder_mean(&alloc_latency);
+    result->min_alloc_time_ns = alloc_latency.min;
+    result->max_alloc_time_ns = alloc_latency.max;
+    result->p50_alloc_time_ns = latency_recorder_percentile(&alloc_latency, 0.50);
+    result->p99_alloc_time_ns = latency_recorder_percentile(&alloc_latency, 0.99);
+    result->total_time_ms = total_time_ns / 1e6;
+    result->total_requested_bytes = bytes;
+    result->total_allocated_bytes = bytes;
     result->fragmentation_ratio = BENCHMARK_METRIC_NA;
 
+    benchmark_result_add_metric(result, "producers", producers);
+    benchmark_result_add_metric(result, "consumers", consumers);
+    benchmark_result_add_metric(result, "queue_depth", (double)(ring.mask + 1));
+    benchmark_result_add_metric(result, "avg_free_time_ns", latency_recorder_mean(&free_latency));
+    benchmark_result_add_metric(result, "p50_free_time_ns", latency_recorder_percentile(&free_latency, 0.50));
+    benchmark_result_add_metric(result, "p99_free_time_ns", latency_recorder_percentile(&free_latency, 0.99));
+    benchmark_result_add_metric(result, "rss_growth_kb", (double)(rss_peak_kb - rss_start_kb));
+    benchmark_result_add_metric(result, "rss_retained_kb",
+                                rss_end_kb > rss_start_kb ? (double)(rss_end_kb - rss_start_kb) : 0.0);
+
+    latency_recorder_destroy(&alloc_latency);
+    latency_recorder_destroy(&free_latency);
+
     return 0;
 }
 
+/* Operation classes tracked separately by bench_parallel_stress. */
+enum {
+    STRESS_MALLOC,
+    STRESS_CALLOC,
+    STRESS_REALLOC,
+    STRESS_ALIGNED,
+    STRESS_FREE,
+    STRESS_REMOTE_FREE,
+    STRESS_OP_COUNT
+};
+
+static const char* stress_op_names[STRESS_OP_COUNT] = {
+    "malloc", "calloc", "realloc", "aligned", "free", "remote_free"
+};
+
+#define STRESS_SAMPLES_PER_OP 16384
+
+/* Pointers from aligned_alloc carry this tag in the low bit so whichever
+ * thread ends up owning them knows to release them with aligned_free. */
+#define STRESS_ALIGNED_TAG ((uintptr_t)1)
+
+typedef struct {
+    allocator_api_t* api;
+    start_barrier_t* start_barrier;
+    atomic_int* finished;
+    _Atomic(uintptr_t)* shared;
+    size_t shared_count;
+    size_t local_slots;
+    size_t operations;
+    const size_dist_t* dist;
+    unsigned int handoff_per_mille;
+    unsigned int seed;
+    double sample_interval_ms;
+    latency_recorder_t latency[STRESS_OP_COUNT];
+    size_t op_count[STRESS_OP_COUNT];
+    size_t handoffs;
+    size_t bytes;
+    size_t failures;
+    double start_ns;
+    double end_ns;
+    benchmark_series_t series;
+} stress_thread_args_t;
+
+static void stress_release(stress_thread_args_t* args, uintptr_t tagged, int op) {
+    allocator_api_t* api = args->api;
+    void* ptr = (void*)(tagged & ~STRESS_ALIGNED_TAG);
+    hr_timer_t timer;
+
+    hr_timer_init(&timer);
+    hr_timer_start(&timer);
+    if (tagged & STRESS_ALIGNED_TAG)
+        api->aligned_free(ptr);
+    else
+        api->free(ptr);
+    latency_recorder_add(&args->latency[op], hr_timer_end(&timer));
+    args->op_count[op]++;
+}
+
+static THREAD_FUNC stress_thread_func(THREAD_ARG arg) {
+    stress_thread_args_t* args = (stress_thread_args_t*)arg;
+    allocator_api_t* api = args->api;
+    hr_timer_t timer;
+
+    uintptr_t* slots = calloc(args->local_slots, sizeof(uintptr_t));
+    size_t* sizes = calloc(args->local_slots, sizeof(size_t));
+
+    if (!start_barrier_wait(args->start_barrier)) {
+        free(slots);
+        free(sizes);
+        thread_return();
+    }
+    args->start_ns = timer_now_ns();
+    if (!slots || !sizes) {
+        args->failures++;
+        args->end_ns = args->start_ns;
+        free(slots);
+        free(sizes);
+        atomic_fetch_add(args->finished, 1);
+        thread_return();
+    }
+
+    series_sampler_t sampler;
+    series_sampler_init_at(&sampler, &args->series, args->sample_interval_ms, args->start_ns);
+
+    for (size_t i = 0; i < args->operations; i++) {
+        size_t idx = xorshift32(&args->seed) % args->local_slots;
+        unsigned int roll = xorshift32(&args->seed) % 100;
+
+        if (!slots[idx]) {
+            size_t size = size_dist_sample(args->dist, &args->seed);
+            uintptr_t tagged;
+            int op;
+
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            if (roll < 60) {
+                op = STRESS_MALLOC;
+                tagged = (uintptr_t)api->malloc(size);
+            } else if (roll < 80) {
+                op = STRESS_CALLOC;
+                tagged = (uintptr_t)api->calloc(1, size);
+            } else {
+                op = STRESS_ALIGNED;
+                size_t alignment = (size_t)16 << (xorshift32(&args->seed) % 9);
+                size = (size + alignment - 1) & ~(alignment - 1);
+                tagged = (uintptr_t)api->aligned_alloc(alignment, size);
+                if (tagged) tagged |= STRESS_ALIGNED_TAG;
+            }
+            latency_recorder_add(&args->latency[op], hr_timer_end(&timer));
+            args->op_count[op]++;
+
+            if (!tagged) {
+                args->failures++;
+                continue;
+            }
+            memset((void*)(tagged & ~STRESS_ALIGNED_TAG), (int)i,
+                   size < CACHE_LINE_SIZE ? size : CACHE_LINE_SIZE);
+            slots[idx] = tagged;
+            sizes[idx] = size;
+            args->bytes += size;
+        } else if (roll < 30 && !(slots[idx] & STRESS_ALIGNED_TAG)) {
+            /* aligned_alloc memory is never resized: _aligned_malloc blocks cannot
+             * go through realloc on Windows. */
+            size_t size = size_dist_sample(args->dist, &args->seed);
+
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            void* ptr = api->realloc((void*)slots[idx], size);
+            latency_recorder_add(&args->latency[STRESS_REALLOC], hr_timer_end(&timer));
+            args->op_count[STRESS_REALLOC]++;
+
+            if (!ptr) {
+                args->failures++;
+                continue;
+            }
+            if (size > sizes[idx]) args->bytes += size - sizes[idx];
+            slots[idx] = (uintptr_t)ptr;
+            sizes[idx] = size;
+        } else if (xorshift32(&args->seed) % 1000 < args->handoff_per_mille) {
+            /* Park the object in a shared slot; whatever was there is now ours to free. */
+            size_t shared_idx = xorshift32(&args->seed) % args->shared_count;
+            uintptr_t previous = atomic_exchange_explicit(&args->shared[shared_idx], slots[idx],
+                                                          memory_order_acq_rel);
+            slots[idx] = 0;
+            args->handoffs++;
+            if (previous) stress_release(args, previous, STRESS_REMOTE_FREE);
+        } else {
+            stress_release(args, slots[idx], STRESS_FREE);
+            slots[idx] = 0;
+        }
+        series_sampler_add(&sampler, 1);
+    }
+
+    for (size_t i = 0; i < args->local_slots; i++) {
+        if (slots[i]) stress_release(args, slots[i], STRESS_FREE);
+    }
+
+    args->end_ns = timer_now_ns();
+    series_sampler_finish(&sampler);
+
+    free(slots);
+    free(sizes);
+    atomic_fetch_add(args->finished, 1);
+    thread_return();
+}
+
 int bench_parallel_stress(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &stress_config;
+
+    int thread_count = (int)benchmark_param_size(cfg, "threads", (size_t)cfg->thread_count);
+    size_t min_size = benchmark_param_size(cfg, "stress_min", cfg->min_size);
+    size_t max_size = benchmark_param_size(cfg, "stress_max", cfg->max_size);
+    size_t local_slots = benchmark_param_size(cfg, "slots", 256);
+    size_t shared_count = benchmark_param_size(cfg, "shared_slots", 1024);
+    double handoff = benchmark_param_double(cfg, "handoff", 0.25);
+    if (thread_count < 1) thread_count = 1;
+    if (min_size < 1) min_size = 1;
+    if (max_size < min_size) max_size = min_size;
+    if (local_slots < 1) local_slots = 1;
+    if (shared_count < 1) shared_count = 1;
+    if (handoff < 0.0) handoff = 0.0;
+    if (handoff > 1.0) handoff = 1.0;
+
+    /* Log-uniform by default: a plain uniform draw over 8 B..1 MB would
+     * almost never produce a small object. */
+    char default_spec[SIZE_DIST_MAX_SPEC];
+    snprintf(default_spec, sizeof(default_spec), "loguniform:%zu-%zu", min_size, max_size);
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist ? cfg->size_dist : default_spec,
+                       min_size, max_size) != 0) return -1;
+
+    _Atomic(uintptr_t)* shared = malloc(shared_count * sizeof(*shared));
+    THREAD_TYPE* threads = malloc(thread_count * sizeof(THREAD_TYPE));
+    stress_thread_args_t* args = calloc(thread_count, sizeof(stress_thread_args_t));
+    if (!shared || !threads || !args) {
+        free(shared);
+        free(threads);
+        free(args);
+        return -1;
+    }
+    for (size_t i = 0; i < shared_count; i++) {
+        atomic_init(&shared[i], 0);
+    }
+
+    start_barrier_t start_barrier;
+    start_barrier_init(&start_barrier);
+    atomic_int finished;
+    atomic_init(&finished, 0);
+
+    int ok = 1;
+    for (int i = 0; i < thread_count; i++) {
+        args[i].api = api;
+        args[i].start_barrier = &start_barrier;
+        args[i].finished = &finished;
+        args[i].shared = shared;
+        args[i].shared_count = shared_count;
+        args[i].local_slots = local_slots;
+        args[i].operations = cfg->iterations / thread_count;
+        args[i].dist = &dist;
+        args[i].handoff_per_mille = (unsigned int)(handoff * 1000.0 + 0.5);
+        args[i].seed = cfg->seed + i * 12345;
+        args[i].sample_interval_ms = cfg->sample_interval_ms;
+        for (int op = 0; op < STRESS_OP_COUNT; op++) {
+            if (latency_recorder_init(&args[i].latency[op], STRESS_SAMPLES_PER_OP) != 0) ok = 0;
+        }
+    }
+
+    size_t rss_start_kb = memory_stats_sample();
+    size_t rss_peak_kb = rss_start_kb;
+
+    int started = 0;
+    while (ok && started < thread_count &&
+           thread_create(&threads[started], stress_thread_func, &args[started]) == 0) {
+        started++;
+    }
+    if (started < thread_count) {
+        start_barrier_abort(&start_barrier);
+        for (int i = 0; i < started; i++) thread_join(threads[i]);
+        ok = 0;
+    }
+
+    if (ok) {
+        start_barrier_release(&start_barrier, started);
+
+        while (atomic_load(&finished) < thread_count) {
+            size_t rss = memory_stats_sample();
+            if (rss > rss_peak_kb) rss_peak_kb = rss;
+            thread_sleep_us(1000);
+        }
+
+        for (int i = 0; i < thread_count; i++) {
+            thread_join(threads[i]);
+        }
+    }
+
+    start_barrier_destroy(&start_barrier);
+
+    /* Objects still parked in shared slots belong to nobody; the harness frees them. */
+    for (size_t i = 0; i < shared_count; i++) {
+        uintptr_t tagged = atomic_load(&shared[i]);
+        if (!tagged) continue;
+        void* ptr = (void*)(tagged & ~STRESS_ALIGNED_TAG);
+        if (tagged & STRESS_ALIGNED_TAG)
+            api->aligned_free(ptr);
+        else
+            api->free(ptr);
+    }
+    free(shared);
+
+    latency_recorder_t merged[STRESS_OP_COUNT];
+    for (int op = 0; op < STRESS_OP_COUNT; op++) {
+        latency_recorder_init(&merged[op], STRESS_SAMPLES_PER_OP * 4);
+    }
+
+    double first_start_ns = args[0].start_ns;
+    double last_end_ns = args[0].end_ns;
+    size_t op_totals[STRESS_OP_COUNT] = {0};
+    size_t handoffs = 0, bytes = 0, failures = 0;
+
+    for (int i = 0; i < thread_count; i++) {
+        if (args[i].start_ns < first_start_ns) first_start_ns = args[i].start_ns;
+        if (args[i].end_ns > last_end_ns) last_end_ns = args[i].end_ns;
+        for (int op = 0; op < STRESS_OP_COUNT; op++) {
+            latency_recorder_merge(&merged[op], &args[i].latency[op]);
+            latency_recorder_destroy(&args[i].latency[op]);
+            op_totals[op] += args[i].op_count[op];
+        }
+        handoffs += args[i].handoffs;
+        bytes += args[i].bytes;
+        failures += args[i].failures;
+        series_merge(&result->throughput_series, &args[i].series);
+    }
+
+    free(threads);
+    free(args);
+
+    if (!ok || failures > 0) {
+        for (int op = 0; op < STRESS_OP_COUNT; op++) latency_recorder_destroy(&merged[op]);
+        return -1;
+    }
+
+    double total_time_ns = last_end_ns - first_start_ns;
+    size_t allocs = op_totals[STRESS_MALLOC] + op_totals[STRESS_CALLOC] + op_totals[STRESS_ALIGNED];
+    size_t frees = op_totals[STRESS_FREE] + op_totals[STRESS_REMOTE_FREE];
+    size_t total_ops = allocs + frees + op_totals[STRESS_REALLOC];
+
+    result->operations_count = total_ops;
+    result->thread_count = thread_count;
+    result->alloc_ops_per_sec = (double)allocs / (total_time_ns / 1e9);
+    result->free_ops_per_sec = (double)frees / (total_time_ns / 1e9);
+    result->realloc_ops_per_sec = (double)op_totals[STRESS_REALLOC] / (total_time_ns / 1e9);
+    result->total_ops_per_sec = (double)total_ops / (total_time_ns / 1e9);
+    result->avg_alloc_time_ns = latency_recorder_mean(&merged[STRESS_MALLOC]);
+    result->min_alloc_time_ns = merged[STRESS_MALLOC].min;
+    result->max_alloc_time_ns = merged[STRESS_MALLOC].max;
+    result->p50_alloc_time_ns = latency_recorder_percentile(&merged[STRESS_MALLOC], 0.50);
+    result->p99_alloc_time_ns = latency_recorder_percentile(&merged[STRESS_MALLOC], 0.99);
+    result->total_time_ms = total_time_ns / 1e6;
+    result->total_requested_bytes = bytes;
+    result->total_allocated_bytes = bytes;
+    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+    char name[MAX_METRIC_NAME];
+    for (int op = 0; op < STRESS_OP_COUNT; op++) {
+        snprintf(name, sizeof(name), "%s_ops", stress_op_names[op]);
+        benchmark_result_add_metric(result, name, (double)op_totals[op]);
+        snprintf(name, sizeof(name), "avg_%s_ns", stress_op_names[op]);
+        benchmark_result_add_metric(result, name, latency_recorder_mean(&merged[op]));
+        snprintf(name, sizeof(name), "p99_%s_ns", stress_op_names[op]);
+        benchmark_result_add_metric(result, name, latency_recorder_percentile(&merged[op], 0.99));
+        latency_recorder_destroy(&merged[op]);
+    }
+    benchmark_result_add_metric(result, "handoff_fraction", handoff);
+    benchmark_result_add_metric(result, "handoffs", (double)handoffs);
+    benchmark_result_add_metric(result, "rss_peak_growth_kb", (double)(rss_peak_kb - rss_start_kb));
+
+    return 0;
+}
+
+typedef struct {
+    allocator_api_t* api;
+    size_t allocations;
+    const size_dist_t* dist;
+    unsigned int seed;
+    void** kept;
+    size_t kept_count;
+    double first_alloc_ns;
+    latency_recorder_t* latency;
+    size_t failures;
+} churn_thread_args_t;
+
+/* Short-lived worker: the first malloc pays for thread-cache setup, half the
+ * objects die locally and the other half are left for the spawner to free. */
+static THREAD_FUNC churn_thread_func(THREAD_ARG arg) {
+    churn_thread_args_t* args = (churn_thread_args_t*)arg;
+    allocator_api_t* api = args->api;
+    hr_timer_t timer;
+
+    args->kept_count = 0;
+    for (size_t i = 0; i < args->allocations; i++) {
+        size_t size = size_dist_sample(args->dist, &args->seed);
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        void* ptr = api->malloc(size);
+        double elapsed = hr_timer_end(&timer);
+
+        if (i == 0)
+            args->first_alloc_ns = elapsed;
+        else
+            latency_recorder_add(args->latency, elapsed);
+
+        if (!ptr) {
+            args->failures++;
+            continue;
+        }
+        memset(ptr, (int)i, size < CACHE_LINE_SIZE ? size : CACHE_LINE_SIZE);
+
+        if (i & 1)
+            api->free(ptr);
+        else
+            args->kept[args->kept_count++] = ptr;
+    }
+
+    thread_return();
+}
+
+int bench_thread_churn(allocator_api_t* api, benchmark_result_t* result, void* config) {
     benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
 
-    result->operations_count = cfg->iterations * 4;
-    result->thread_count = 4;
-    result->alloc_ops_per_sec = cfg->iterations / 0.001;
-    result->total_ops_per_sec = result->alloc_ops_per_sec;
-    result->avg_alloc_time_ns = 1000.0;
+    size_t lifetimes = benchmark_param_size(cfg, "lifetimes", 10000);
+    size_t allocations = benchmark_param_size(cfg, "allocs_per_thread", 64);
+    int concurrency = (int)benchmark_param_size(cfg, "concurrency", 4);
+    if (lifetimes < 1) lifetimes = 1;
+    if (allocations < 1) allocations = 1;
+    if (concurrency < 1) concurrency = 1;
+
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
+
+    THREAD_TYPE* threads = malloc(concurrency * sizeof(THREAD_TYPE));
+    churn_thread_args_t* args = calloc(concurrency, sizeof(churn_thread_args_t));
+    latency_recorder_t* latency = calloc(concurrency, sizeof(latency_recorder_t));
+    if (!threads || !args || !latency) {
+        free(threads);
+        free(args);
+        free(latency);
+        return -1;
+    }
+
+    int ok = 1;
+    for (int i = 0; i < concurrency; i++) {
+        args[i].api = api;
+        args[i].allocations = allocations;
+        args[i].dist = &dist;
+        args[i].latency = &latency[i];
+        args[i].kept = malloc(((allocations + 1) / 2) * sizeof(void*));
+        if (!args[i].kept) ok = 0;
+        if (latency_recorder_init(&latency[i], LATENCY_SAMPLES_PER_THREAD / 4) != 0) ok = 0;
+    }
+
+    latency_recorder_t first_use;
+    if (latency_recorder_init(&first_use, LATENCY_SAMPLES_PER_THREAD) != 0) ok = 0;
+
+    size_t rss_start_kb = memory_stats_sample();
+    size_t rss_after_first_kb = rss_start_kb;
+    size_t completed = 0, allocs = 0, frees = 0, failures = 0;
+    unsigned int seed = cfg->seed;
+
+    series_sampler_t sampler;
+    series_sampler_init(&sampler, &result->throughput_series, cfg->sample_interval_ms);
+    double start_ns = timer_now_ns();
+
+    while (ok && completed < lifetimes) {
+        int batch = concurrency;
+        if ((size_t)batch > lifetimes - completed) batch = (int)(lifetimes - completed);
+
+        int started = 0;
+        for (; started < batch; started++) {
+            args[started].seed = seed + (unsigned int)(completed + started) * 12345u;
+            if (thread_create(&threads[started], churn_thread_func, &args[started]) != 0) break;
+        }
+        if (started < batch) ok = 0;
+
+        size_t batch_ops = allocs + frees;
+        for (int i = 0; i < started; i++) {
+            thread_join(threads[i]);
+
+            latency_recorder_add(&first_use, args[i].first_alloc_ns);
+            failures += args[i].failures;
+            allocs += allocations - args[i].failures;
+            frees += allocations - args[i].failures - args[i].kept_count;
+
+            for (size_t k = 0; k < args[i].kept_count; k++) {
+                api->free(args[i].kept[k]);
+            }
+            frees += args[i].kept_count;
+        }
+        if (!ok) break;
+
+        completed += batch;
+        series_sampler_add(&sampler, allocs + frees - batch_ops);
+        if (completed == (size_t)batch) rss_after_first_kb = memory_stats_sample();
+    }
+
+    double total_time_ns = timer_now_ns() - start_ns;
+    series_sampler_finish(&sampler);
+    size_t rss_end_kb = memory_stats_sample();
+
+    latency_recorder_t steady;
+    latency_recorder_init(&steady, LATENCY_SAMPLES_PER_THREAD);
+    for (int i = 0; i < concurrency; i++) {
+        latency_recorder_merge(&steady, &latency[i]);
+        latency_recorder_destroy(&latency[i]);
+        free(args[i].kept);
+    }
+
+    free(threads);
+    free(args);
+    free(latency);
+
+    if (!ok || failures > 0) {
+        latency_recorder_destroy(&first_use);
+        latency_recorder_destroy(&steady);
+        return -1;
+    }
+
+    result->operations_count = allocs + frees;
+    result->thread_count = concurrency;
+    result->alloc_ops_per_sec = (double)allocs / (total_time_ns / 1e9);
+    result->free_ops_per_sec = (double)frees / (total_time_ns / 1e9);
+    result->total_ops_per_sec = (double)result->operations_count / (total_time_ns / 1e9);
+    result->avg_alloc_time_ns = latency_recorder_mean(&first_use);
+    result->min_alloc_time_ns = first_use.min;
+    result->max_alloc_time_ns = first_use.max;
+    result->p50_alloc_time_ns = latency_recorder_percentile(&first_use, 0.50);
+    result->p99_alloc_time_ns = latency_recorder_percentile(&first_use, 0.99);
+    result->total_time_ms = total_time_ns / 1e6;
+    result->total_requested_bytes = (size_t)(allocs * dist.mean_size);
+    result->total_allocated_bytes = result->total_requested_bytes;
+    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+    double retained_kb = rss_end_kb > rss_after_first_kb ? (double)(rss_end_kb - rss_after_first_kb) : 0.0;
+
+    benchmark_result_add_metric(result, "threads_per_sec", (double)completed / (total_time_ns / 1e9));
+    benchmark_result_add_metric(result, "lifetimes", (double)completed);
+    benchmark_result_add_metric(result, "allocs_per_thread", (double)allocations);
+    benchmark_result_add_metric(result, "avg_later_alloc_ns", latency_recorder_mean(&steady));
+    benchmark_result_add_metric(result, "p99_later_alloc_ns", latency_recorder_percentile(&steady, 0.99));
+    benchmark_result_add_metric(result, "rss_retained_kb",
+                                rss_end_kb > rss_start_kb ? (double)(rss_end_kb - rss_start_kb) : 0.0);
+    benchmark_result_add_metric(result, "rss_retained_per_1k_kb", retained_kb * 1000.0 / (double)completed);
+
+    latency_recorder_destroy(&first_use);
+    latency_recorder_destroy(&steady);
+
+    return 0;
+}
+
+/* Intrusive MPSC queue (Vyukov): producers only swap the head, so a push is
+ * one atomic exchange no matter how many threads are logging. */
+typedef struct mpsc_node {
+    _Atomic(struct mpsc_node*) next;
+} mpsc_node_t;
+
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) _Atomic(mpsc_node_t*) head;
+    _Alignas(CACHE_LINE_SIZE) mpsc_node_t* tail;
+    mpsc_node_t stub;
+} mpsc_queue_t;
+
+static void mpsc_init(mpsc_queue_t* queue) {
+    atomic_init(&queue->stub.next, NULL);
+    atomic_init(&queue->head, &queue->stub);
+    queue->tail = &queue->stub;
+}
+
+static void mpsc_push(mpsc_queue_t* queue, mpsc_node_t* node) {
+    atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+    mpsc_node_t* prev = atomic_exchange_explicit(&queue->head, node, memory_order_acq_rel);
+    atomic_store_explicit(&prev->next, node, memory_order_release);
+}
+
+/* Returns NULL when empty or when a producer is midway through a push. */
+static mpsc_node_t* mpsc_pop(mpsc_queue_t* queue) {
+    mpsc_node_t* tail = queue->tail;
+    mpsc_node_t* next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+    if (tail == &queue->stub) {
+        if (!next) return NULL;
+        queue->tail = next;
+        tail = next;
+        next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    }
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+
+    if (tail != atomic_load_explicit(&queue->head, memory_order_acquire)) return NULL;
+
+    mpsc_push(queue, &queue->stub);
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+    return NULL;
+}
+
+typedef struct {
+    allocator_api_t* api;
+    mpsc_queue_t* queue;
+    start_barrier_t* start_barrier;
+    atomic_size_t* backlog;
+    atomic_size_t* sent;
+    atomic_int* finished;
+    int producers;
+    size_t max_backlog;
+    size_t messages;
+    const size_dist_t* dist;
+    unsigned int seed;
+    int id;
+    latency_recorder_t latency;
+    size_t count;
+    size_t bytes;
+    size_t failures;
+    size_t peak_backlog;
+    size_t checksum;
+    double start_ns;
+    double end_ns;
+} logger_thread_args_t;
+
+static THREAD_FUNC logger_producer_func(THREAD_ARG arg) {
+    logger_thread_args_t* args = (logger_thread_args_t*)arg;
+    allocator_api_t* api = args->api;
+    hr_timer_t timer;
+
+    if (!start_barrier_wait(args->start_barrier)) thread_return();
+    args->start_ns = timer_now_ns();
+
+    for (size_t i = 0; i < args->messages; i++) {
+        /* Bound the backlog so a slow consumer cannot exhaust memory. */
+        while (atomic_load_explicit(args->backlog, memory_order_relaxed) >= args->max_backlog) {
+            thread_yield();
+        }
+
+        size_t size = size_dist_sample(args->dist, &args->seed);
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        mpsc_node_t* msg = api->malloc(size);
+        latency_recorder_add(&args->latency, hr_timer_end(&timer));
+
+        if (!msg) {
+            args->failures++;
+            continue;
+        }
+
+        char* text = (char*)(msg + 1);
+        snprintf(text, size - sizeof(mpsc_node_t), "[producer %d] message %zu: %zu bytes",
+                 args->id, i, size);
+        args->bytes += size;
+        args->count++;
+
+        atomic_fetch_add_explicit(args->backlog, 1, memory_order_relaxed);
+        mpsc_push(args->queue, msg);
+    }
+
+    args->end_ns = timer_now_ns();
+    atomic_fetch_add(args->sent, args->count);
+    atomic_fetch_add(args->finished, 1);
+    thread_return();
+}
+
+static THREAD_FUNC logger_consumer_func(THREAD_ARG arg) {
+    logger_thread_args_t* args = (logger_thread_args_t*)arg;
+    allocator_api_t* api = args->api;
+    hr_timer_t timer;
+
+    if (!start_barrier_wait(args->start_barrier)) thread_return();
+    args->start_ns = timer_now_ns();
+
+    /* A failed malloc sends nothing, so the total is only known once every
+     * producer has finished; until then keep draining. */
+    for (;;) {
+        mpsc_node_t* msg = mpsc_pop(args->queue);
+        if (!msg) {
+            if (atomic_load(args->finished) >= args->producers &&
+                args->count == atomic_load(args->sent)) break;
+            thread_yield();
+            continue;
+        }
+
+        size_t backlog = atomic_fetch_sub_explicit(args->backlog, 1, memory_order_relaxed);
+        if (backlog > args->peak_backlog) args->peak_backlog = backlog;
+        /* Read the line like a writer would, pulling it into this core's cache. */
+        args->checksum += (unsigned char)((char*)(msg + 1))[1];
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        api->free(msg);
+        latency_recorder_add(&args->latency, hr_timer_end(&timer));
+        args->count++;
+    }
+
+    args->end_ns = timer_now_ns();
+    atomic_fetch_add(args->finished, 1);
+    thread_return();
+}
+
+int bench_logger_mpsc(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+
+    int producers = (int)benchmark_param_size(cfg, "producers", 4);
+    size_t min_size = benchmark_param_size(cfg, "msg_min", 32);
+    size_t max_size = benchmark_param_size(cfg, "msg_max", 512);
+    size_t max_backlog = benchmark_param_size(cfg, "max_backlog", 65536);
+    if (producers < 1) producers = 1;
+    if (min_size < sizeof(mpsc_node_t) + 2) min_size = sizeof(mpsc_node_t) + 2;
+    if (max_size < min_size) max_size = min_size;
+
+    size_dist_t dist;
+    size_dist_uniform(&dist, min_size, max_size);
+    if (max_backlog < 1) max_backlog = 1;
+
+    int thread_count = producers + 1;
+    size_t per_producer = cfg->iterations / producers;
+
+    THREAD_TYPE* threads = malloc(thread_count * sizeof(THREAD_TYPE));
+    logger_thread_args_t* args = calloc(thread_count, sizeof(logger_thread_args_t));
+    if (!threads || !args) {
+        free(threads);
+        free(args);
+        return -1;
+    }
+
+    mpsc_queue_t queue;
+    mpsc_init(&queue);
+    start_barrier_t start_barrier;
+    start_barrier_init(&start_barrier);
+    atomic_size_t backlog, sent;
+    atomic_int finished;
+    atomic_init(&backlog, 0);
+    atomic_init(&sent, 0);
+    atomic_init(&finished, 0);
+
+    int ok = 1;
+    for (int i = 0; i < thread_count; i++) {
+        args[i].api = api;
+        args[i].queue = &queue;
+        args[i].start_barrier = &start_barrier;
+        args[i].backlog = &backlog;
+        args[i].sent = &sent;
+        args[i].finished = &finished;
+        args[i].producers = producers;
+        args[i].max_backlog = max_backlog;
+        args[i].messages = per_producer;
+        args[i].dist = &dist;
+        args[i].seed = cfg->seed + i * 12345;
+        args[i].id = i;
+        if (latency_recorder_init(&args[i].latency, LATENCY_SAMPLES_PER_THREAD) != 0) ok = 0;
+    }
+
+    logger_thread_args_t* consumer = &args[producers];
+
+    size_t rss_start_kb = memory_stats_sample();
+    size_t rss_peak_kb = rss_start_kb;
+
+    int started = 0;
+    while (ok && started < thread_count &&
+           thread_create(&threads[started], started < producers ? logger_producer_func : logger_consumer_func,
+                         &args[started]) == 0) {
+        started++;
+    }
+    if (started < thread_count) {
+        start_barrier_abort(&start_barrier);
+        for (int i = 0; i < started; i++) thread_join(threads[i]);
+        ok = 0;
+    }
+
+    if (ok) {
+        start_barrier_release(&start_barrier, started);
+
+        /* Frees the allocator has not yet reclaimed from its remote lists show up as RSS. */
+        while (atomic_load(&finished) < thread_count) {
+            size_t rss = memory_stats_sample();
+            if (rss > rss_peak_kb) rss_peak_kb = rss;
+            thread_sleep_us(1000);
+        }
+
+        for (int i = 0; i < thread_count; i++) {
+            thread_join(threads[i]);
+        }
+    }
+
+    start_barrier_destroy(&start_barrier);
+    size_t rss_end_kb = memory_stats_sample();
+    if (rss_end_kb > rss_peak_kb) rss_peak_kb = rss_end_kb;
+
+    latency_recorder_t alloc_latency;
+    latency_recorder_init(&alloc_latency, LATENCY_SAMPLES_PER_THREAD);
+
+    size_t produced = 0, failures = 0, bytes = 0;
+    double first_start_ns = args[0].start_ns;
+    double last_end_ns = args[0].end_ns;
+    for (int i = 0; i < producers; i++) {
+        if (args[i].start_ns < first_start_ns) first_start_ns = args[i].start_ns;
+        if (args[i].end_ns > last_end_ns) last_end_ns = args[i].end_ns;
+        latency_recorder_merge(&alloc_latency, &args[i].latency);
+        latency_recorder_destroy(&args[i].latency);
+        produced += args[i].count;
+        failures += args[i].failures;
+        bytes += args[i].bytes;
+    }
+    if (consumer->end_ns > last_end_ns) last_end_ns = consumer->end_ns;
+
+    double consumer_time_ns = consumer->end_ns - consumer->start_ns;
+    double total_time_ns = last_end_ns - first_start_ns;
+    size_t consumed = consumer->count;
+    size_t peak_backlog = consumer->peak_backlog;
+    double avg_free_ns = latency_recorder_mean(&consumer->latency);
+    double p99_free_ns = latency_recorder_percentile(&consumer->latency, 0.99);
+    latency_recorder_destroy(&consumer->latency);
+
+    free(threads);
+    free(args);
+
+    if (!ok || failures > 0 || consumed != produced) {
+        latency_recorder_destroy(&alloc_latency);
+        return -1;
+    }
+
+    result->operations_count = produced + consumed;
+    result->thread_count = thread_count;
+    result->alloc_ops_per_sec = (double)produced / (total_time_ns / 1e9);
+    result->free_ops_per_sec = (double)consumed / (consumer_time_ns / 1e9);
+    result->total_ops_per_sec = (double)result->operations_count / (total_time_ns / 1e9);
+    result->avg_alloc_time_ns = latency_recorder_mean(&alloc_latency);
+    result->min_alloc_time_ns = alloc_latency.min;
+    result->max_alloc_time_ns = alloc_latency.max;
+    result->p50_alloc_time_ns = latency_recorder_percentile(&alloc_latency, 0.50);
+    result->p99_alloc_time_ns = latency_recorder_percentile(&alloc_latency, 0.99);
+    result->total_time_ms = total_time_ns / 1e6;
+    result->total_requested_bytes = bytes;
+    result->total_allocated_bytes = bytes;
+    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+    benchmark_result_add_metric(result, "producers", producers);
+    benchmark_result_add_metric(result, "consumer_frees_per_sec", (double)consumed / (consumer_time_ns / 1e9));
+    benchmark_result_add_metric(result, "avg_free_time_ns", avg_free_ns);
+    benchmark_result_add_metric(result, "p99_free_time_ns", p99_free_ns);
+    benchmark_result_add_metric(result, "peak_backlog", (double)peak_backlog);
+    benchmark_result_add_metric(result, "rss_growth_kb", (double)(rss_peak_kb - rss_start_kb));
+    benchmark_result_add_metric(result, "rss_retained_kb",
+                                rss_end_kb > rss_start_kb ? (double)(rss_end_kb - rss_start_kb) : 0.0);
+
+    latency_recorder_destroy(&alloc_latency);
+
+    return 0;
+}
+
+typedef struct {
+    allocator_api_t* api;
+    start_barrier_t* alloc_barrier;
+    BARRIER_TYPE* update_barrier;
+    size_t objects;
+    size_t passes;
+    const size_dist_t* dist;
+    unsigned int seed;
+    void** ptrs;
+    size_t* sizes;
+    size_t failures;
+    double update_start_ns;
+    double update_end_ns;
+} sharing_thread_args_t;
+
+static THREAD_FUNC sharing_thread_func(THREAD_ARG arg) {
+    sharing_thread_args_t* args = (sharing_thread_args_t*)arg;
+    allocator_api_t* api = args->api;
+
+    /* Allocation phase runs concurrently so per-thread heaps compete for lines. */
+    if (!start_barrier_wait(args->alloc_barrier)) thread_return();
+    for (size_t i = 0; i < args->objects; i++) {
+        size_t size = size_dist_sample(args->dist, &args->seed);
+        args->ptrs[i] = api->malloc(size);
+        args->sizes[i] = size;
+        if (args->ptrs[i])
+            memset(args->ptrs[i], 0, size);
+        else
+            args->failures++;
+    }
+
+    barrier_wait(args->update_barrier);
+    args->update_start_ns = timer_now_ns();
+
+    for (size_t pass = 0; pass < args->passes; pass++) {
+        for (size_t i = 0; i < args->objects; i++) {
+            volatile uint64_t* counter = (volatile uint64_t*)args->ptrs[i];
+            if (counter) *counter += 1;
+        }
+    }
+
+    args->update_end_ns = timer_now_ns();
+    thread_return();
+}
+
+typedef struct {
+    uintptr_t line;
+    int owner;
+} line_owner_t;
+
+static int compare_line_owner(const void* a, const void* b) {
+    const line_owner_t* la = (const line_owner_t*)a;
+    const line_owner_t* lb = (const line_owner_t*)b;
+    if (la->line != lb->line) return la->line < lb->line ? -1 : 1;
+    return la->owner - lb->owner;
+}
+
+int bench_false_sharing(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+
+    int thread_count = (int)benchmark_param_size(cfg, "threads", 4);
+    size_t objects = benchmark_param_size(cfg, "objects", 1024);
+    size_t min_size = benchmark_param_size(cfg, "obj_min", 8);
+    size_t max_size = benchmark_param_size(cfg, "obj_max", 64);
+    if (thread_count < 1) thread_count = 1;
+    if (objects < 1) objects = 1;
+    if (min_size < sizeof(uint64_t)) min_size = sizeof(uint64_t);
+    if (max_size < min_size) max_size = min_size;
+
+    size_dist_t dist;
+    size_dist_uniform(&dist, min_size, max_size);
+
+    size_t passes = cfg->iterations / objects;
+    if (passes < 1) passes = 1;
+
+    THREAD_TYPE* threads = malloc(thread_count * sizeof(THREAD_TYPE));
+    sharing_thread_args_t* args = calloc(thread_count, sizeof(sharing_thread_args_t));
+    size_t lines_per_object = max_size / CACHE_LINE_SIZE + 2;
+    line_owner_t* lines = malloc((size_t)thread_count * objects * lines_per_object * sizeof(line_owner_t));
+    if (!threads || !args || !lines) {
+        free(threads);
+        free(args);
+        free(lines);
+        return -1;
+    }
+
+    start_barrier_t alloc_barrier;
+    BARRIER_TYPE update_barrier;
+    start_barrier_init(&alloc_barrier);
+    barrier_init(&update_barrier, thread_count);
+
+    int ok = 1;
+    for (int i = 0; i < thread_count; i++) {
+        args[i].api = api;
+        args[i].alloc_barrier = &alloc_barrier;
+        args[i].update_barrier = &update_barrier;
+        args[i].objects = objects;
+        args[i].passes = passes;
+        args[i].dist = &dist;
+        args[i].seed = cfg->seed + i * 12345;
+        args[i].ptrs = calloc(objects, sizeof(void*));
+        args[i].sizes = calloc(objects, sizeof(size_t));
+        if (!args[i].ptrs || !args[i].sizes) ok = 0;
+    }
+
+    int started = 0;
+    while (ok && started < thread_count &&
+           thread_create(&threads[started], sharing_thread_func, &args[started]) == 0) {
+        started++;
+    }
+    if (started < thread_count) {
+        start_barrier_abort(&alloc_barrier);
+        ok = 0;
+    } else {
+        start_barrier_release(&alloc_barrier, started);
+    }
+    for (int i = 0; i < started; i++) {
+        thread_join(threads[i]);
+    }
+
+    start_barrier_destroy(&alloc_barrier);
+    barrier_destroy(&update_barrier);
+
+    /* Record every cache line each object touches. */
+    size_t line_count = 0;
+    size_t failures = 0;
+    double first_start_ns = args[0].update_start_ns;
+    double last_end_ns = args[0].update_end_ns;
+    for (int t = 0; ok && t < thread_count; t++) {
+        failures += args[t].failures;
+        if (args[t].update_start_ns < first_start_ns) first_start_ns = args[t].update_start_ns;
+        if (args[t].update_end_ns > last_end_ns) last_end_ns = args[t].update_end_ns;
+        for (size_t i = 0; i < objects; i++) {
+            if (!args[t].ptrs[i]) continue;
+            uintptr_t first = (uintptr_t)args[t].ptrs[i] / CACHE_LINE_SIZE;
+            uintptr_t last = ((uintptr_t)args[t].ptrs[i] + args[t].sizes[i] - 1) / CACHE_LINE_SIZE;
+            for (uintptr_t line = first; line <= last; line++) {
+                lines[line_count].line = line;
+                lines[line_count].owner = t;
+                line_count++;
+            }
+        }
+    }
+
+    qsort(lines, line_count, sizeof(line_owner_t), compare_line_owner);
+
+    size_t shared_lines = 0, total_lines = 0;
+    for (size_t i = 0; i < line_count;) {
+        size_t j = i;
+        int mixed = 0;
+        while (j < line_count && lines[j].line == lines[i].line) {
+            if (lines[j].owner != lines[i].owner) mixed = 1;
+            j++;
+        }
+        total_lines++;
+        if (mixed) shared_lines++;
+        i = j;
+    }
+
+    /* An object is falsely shared if any line it touches has another owner. */
+    size_t shared_objects = 0, live_objects = 0, requested = 0;
+    for (int t = 0; ok && t < thread_count; t++) {
+        for (size_t i = 0; i < objects; i++) {
+            if (!args[t].ptrs[i]) continue;
+            live_objects++;
+            requested += args[t].sizes[i];
+            uintptr_t first = (uintptr_t)args[t].ptrs[i] / CACHE_LINE_SIZE;
+            uintptr_t last = ((uintptr_t)args[t].ptrs[i] + args[t].sizes[i] - 1) / CACHE_LINE_SIZE;
+            int shared = 0;
+            for (uintptr_t line = first; line <= last && !shared; line++) {
+                line_owner_t key = { line, -1 };
+                size_t lo = 0, hi = line_count;
+                while (lo < hi) {
+                    size_t mid = lo + (hi - lo) / 2;
+                    if (compare_line_owner(&lines[mid], &key) < 0) lo = mid + 1;
+                    else hi = mid;
+                }
+                for (size_t k = lo; k < line_count && lines[k].line == line; k++) {
+                    if (lines[k].owner != t) {
+                        shared = 1;
+                        break;
+                    }
+                }
+            }
+            if (shared) shared_objects++;
+        }
+    }
+
+    for (int t = 0; t < thread_count; t++) {
+        for (size_t i = 0; args[t].ptrs && i < objects; i++) {
+            if (args[t].ptrs[i]) api->free(args[t].ptrs[i]);
+        }
+        free(args[t].ptrs);
+        free(args[t].sizes);
+    }
+
+    free(threads);
+    free(args);
+    free(lines);
+
+    if (!ok || failures > 0) return -1;
+
+    double update_time_ns = last_end_ns - first_start_ns;
+    size_t updates = (size_t)thread_count * objects * passes;
+
+    result->operations_count = updates;
+    result->thread_count = thread_count;
+    result->total_ops_per_sec = (double)updates / (update_time_ns / 1e9);
+    result->avg_alloc_time_ns = BENCHMARK_METRIC_NA;
     result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
     result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
     result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
     result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->total_time_ms = update_time_ns / 1e6;
+    result->total_requested_bytes = requested;
+    result->total_allocated_bytes = requested;
     result->fragmentation_ratio = BENCHMARK_METRIC_NA;
 
+    benchmark_result_add_metric(result, "updates_per_sec", result->total_ops_per_sec);
+    benchmark_result_add_metric(result, "shared_object_fraction",
+                                live_objects ? (double)shared_objects / (double)live_objects : 0.0);
+    benchmark_result_add_metric(result, "shared_line_fraction",
+                                total_lines ? (double)shared_lines / (double)total_lines : 0.0);
+    benchmark_result_add_metric(result, "objects_per_thread", (double)objects);
+
     return 0;
 }
@@ -6,11 +6,10 @@
 void register_threaded_benchmarks(void);
 
 int bench_threaded_alloc(allocator_api_t* api, benchmark_result_t* result, void* config);
-int bench_threaded_alloc_2(allocator_api_t* api, benchmark_result_t* result, void* config);
-int bench_threaded_alloc_4(allocator_api_t* api, benchmark_result_t* result, void* config);
-int bench_threaded_alloc_8(allocator_api_t* api, benchmark_result_t* result, void* config);
-int bench_threaded_alloc_16(allocator_api_t* api, benchmark_result_t* result, void* config);
 int bench_producer_consumer(allocator_api_t* api, benchmark_result_t* result, void* config);
 int bench_parallel_stress(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_thread_churn(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_logger_mpsc(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_false_sharing(allocator_api_t* api, benchmark_result_t* result, void* config);
 
 #endif
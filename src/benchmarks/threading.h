@@ -0,0 +1,119 @@
+#ifndef THREADING_H
+#define THREADING_H
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#define THREAD_TYPE HANDLE
+#define THREAD_FUNC DWORD WINAPI
+#define THREAD_ARG LPVOID
+#define THREAD_RETURN DWORD
+#define thread_create(thread, func, arg) \
+    ((*(thread) = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)(func), (arg), 0, NULL)) != NULL ? 0 : -1)
+#define thread_join(thread) WaitForSingleObject((thread), INFINITE)
+#define thread_return() return 0
+#define thread_yield() SwitchToThread()
+#define thread_sleep_us(us) Sleep((DWORD)(((us) + 999) / 1000))
+
+#define BARRIER_TYPE SYNCHRONIZATION_BARRIER
+#define barrier_init(barrier, count) InitializeSynchronizationBarrier((barrier), (LONG)(count), -1)
+#define barrier_wait(barrier) EnterSynchronizationBarrier((barrier), 0)
+#define barrier_destroy(barrier) DeleteSynchronizationBarrier(barrier)
+
+#define GATE_LOCK_TYPE SRWLOCK
+#define GATE_COND_TYPE CONDITION_VARIABLE
+#define gate_lock_init(lock) InitializeSRWLock(lock)
+#define gate_lock(lock) AcquireSRWLockExclusive(lock)
+#define gate_unlock(lock) ReleaseSRWLockExclusive(lock)
+#define gate_lock_destroy(lock) ((void)(lock))
+#define gate_cond_init(cond) InitializeConditionVariable(cond)
+#define gate_cond_wait(cond, lock) SleepConditionVariableSRW((cond), (lock), INFINITE, 0)
+#define gate_cond_broadcast(cond) WakeAllConditionVariable(cond)
+#define gate_cond_destroy(cond) ((void)(cond))
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#define THREAD_TYPE pthread_t
+#define THREAD_FUNC void*
+#define THREAD_ARG void*
+#define THREAD_RETURN void*
+#define thread_create(thread, func, arg) pthread_create((thread), NULL, (func), (arg))
+#define thread_join(thread) pthread_join((thread), NULL)
+#define thread_return() return NULL
+#define thread_yield() sched_yield()
+#define thread_sleep_us(us) usleep((useconds_t)(us))
+
+#define BARRIER_TYPE pthread_barrier_t
+#define barrier_init(barrier, count) pthread_barrier_init((barrier), NULL, (unsigned)(count))
+#define barrier_wait(barrier) pthread_barrier_wait(barrier)
+#define barrier_destroy(barrier) pthread_barrier_destroy(barrier)
+
+#define GATE_LOCK_TYPE pthread_mutex_t
+#define GATE_COND_TYPE pthread_cond_t
+#define gate_lock_init(lock) pthread_mutex_init((lock), NULL)
+#define gate_lock(lock) pthread_mutex_lock(lock)
+#define gate_unlock(lock) pthread_mutex_unlock(lock)
+#define gate_lock_destroy(lock) pthread_mutex_destroy(lock)
+#define gate_cond_init(cond) pthread_cond_init((cond), NULL)
+#define gate_cond_wait(cond, lock) pthread_cond_wait((cond), (lock))
+#define gate_cond_broadcast(cond) pthread_cond_broadcast(cond)
+#define gate_cond_destroy(cond) pthread_cond_destroy(cond)
+#endif
+
+/* Start barrier that survives a failed spawn. Workers park in
+ * start_barrier_wait until the spawning thread either releases them, which
+ * sizes the barrier to the workers that actually started, or aborts, in
+ * which case start_barrier_wait returns 0 and the worker should exit. */
+typedef struct {
+    GATE_LOCK_TYPE lock;
+    GATE_COND_TYPE cond;
+    int state;
+    BARRIER_TYPE barrier;
+} start_barrier_t;
+
+#define START_BARRIER_PENDING 0
+#define START_BARRIER_RELEASED 1
+#define START_BARRIER_ABORTED (-1)
+
+static inline void start_barrier_init(start_barrier_t* sb) {
+    gate_lock_init(&sb->lock);
+    gate_cond_init(&sb->cond);
+    sb->state = START_BARRIER_PENDING;
+}
+
+static inline int start_barrier_wait(start_barrier_t* sb) {
+    gate_lock(&sb->lock);
+    while (sb->state == START_BARRIER_PENDING) gate_cond_wait(&sb->cond, &sb->lock);
+    int state = sb->state;
+    gate_unlock(&sb->lock);
+
+    if (state != START_BARRIER_RELEASED) return 0;
+    barrier_wait(&sb->barrier);
+    return 1;
+}
+
+/* Called by the spawning thread once all `workers` are running; returns
+ * together with them. */
+static inline void start_barrier_release(start_barrier_t* sb, int workers) {
+    barrier_init(&sb->barrier, workers + 1);
+    gate_lock(&sb->lock);
+    sb->state = START_BARRIER_RELEASED;
+    gate_cond_broadcast(&sb->cond);
+    gate_unlock(&sb->lock);
+    barrier_wait(&sb->barrier);
+}
+
+static inline void start_barrier_abort(start_barrier_t* sb) {
+    gate_lock(&sb->lock);
+    sb->state = START_BARRIER_ABORTED;
+    gate_cond_broadcast(&sb->cond);
+    gate_unlock(&sb->lock);
+}
+
+static inline void start_barrier_destroy(start_barrier_t* sb) {
+    if (sb->state == START_BARRIER_RELEASED) barrier_destroy(&sb->barrier);
+    gate_cond_destroy(&sb->cond);
+    gate_lock_destroy(&sb->lock);
+}
+
+#endif
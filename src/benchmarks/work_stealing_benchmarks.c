@@ -0,0 +1,531 @@
+#include "work_stealing_benchmarks.h"
+#include "timer.h"
+#include "timeseries.h"
+#include "threading.h"
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#define CACHE_LINE_SIZE 64
+#define WS_DEQUE_CAPACITY 4096
+
+static unsigned int xorshift32(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+typedef struct ws_task ws_task_t;
+typedef struct ws_worker ws_worker_t;
+
+/* run returns the number of children it spawned; zero means the task is a
+ * leaf and completes immediately. join runs once the last child completes. */
+struct ws_task {
+    int (*run)(ws_worker_t* worker, ws_task_t* task);
+    void (*join)(ws_task_t* task);
+    ws_task_t* parent;
+    atomic_int pending;
+    void* closure;
+};
+
+/* Chase-Lev deque with the C11 orderings from Le et al., "Correct and
+ * Efficient Work-Stealing for Weak Memory Models" (PPoPP'13). Fixed size:
+ * when it is full the owner runs the task inline instead. */
+typedef struct {
+    _Atomic(ws_task_t*)* buffer;
+    long long mask;
+    _Alignas(CACHE_LINE_SIZE) atomic_llong top;
+    _Alignas(CACHE_LINE_SIZE) atomic_llong bottom;
+} ws_deque_t;
+
+typedef struct {
+    allocator_api_t* api;
+    ws_worker_t* workers;
+    int worker_count;
+    start_barrier_t* start_barrier;
+    _Alignas(CACHE_LINE_SIZE) _Atomic(ws_task_t*) inject;
+    atomic_int job_done;
+    atomic_int shutdown;
+} ws_pool_t;
+
+struct ws_worker {
+    ws_deque_t deque;
+    ws_pool_t* pool;
+    int index;
+    unsigned int seed;
+    size_t executed;
+    size_t steals;
+    size_t failures;
+    benchmark_series_t series;
+    series_sampler_t sampler;
+};
+
+static benchmark_config_t default_config = BENCHMARK_DEFAULT_CONFIG;
+
+static int deque_init(ws_deque_t* deque, size_t capacity) {
+    deque->buffer = malloc(capacity * sizeof(*deque->buffer));
+    if (!deque->buffer) return -1;
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&deque->buffer[i], NULL);
+    }
+    deque->mask = (long long)capacity - 1;
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    return 0;
+}
+
+static void deque_destroy(ws_deque_t* deque) {
+    free((void*)deque->buffer);
+    deque->buffer = NULL;
+}
+
+static int deque_push(ws_deque_t* deque, ws_task_t* task) {
+    long long b = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long long t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if (b - t > deque->mask) return 0;
+
+    atomic_store_explicit(&deque->buffer[b & deque->mask], task, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+    return 1;
+}
+
+static ws_task_t* deque_take(ws_deque_t* deque) {
+    long long b = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long t = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (t > b) {
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    ws_task_t* task = atomic_load_explicit(&deque->buffer[b & deque->mask], memory_order_relaxed);
+    if (t == b) {
+        /* Last element: race the thieves for it. */
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed)) {
+            task = NULL;
+        }
+        atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+static ws_task_t* deque_steal(ws_deque_t* deque) {
+    long long t = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long b = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (t >= b) return NULL;
+
+    ws_task_t* task = atomic_load_explicit(&deque->buffer[t & deque->mask], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &t, t + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        return NULL;
+    }
+    return task;
+}
+
+/* Task and closure are separate allocations, as they are in most schedulers
+ * that box a user lambda next to their own bookkeeping. */
+static ws_task_t* task_new(allocator_api_t* api, int (*run)(ws_worker_t*, ws_task_t*),
+                           void (*join)(ws_task_t*), ws_task_t* parent, size_t closure_size) {
+    ws_task_t* task = api->malloc(sizeof(ws_task_t));
+    if (!task) return NULL;
+
+    task->closure = api->malloc(closure_size);
+    if (!task->closure) {
+        api->free(task);
+        return NULL;
+    }
+    task->run = run;
+    task->join = join;
+    task->parent = parent;
+    atomic_init(&task->pending, 0);
+    return task;
+}
+
+static void task_delete(allocator_api_t* api, ws_task_t* task) {
+    api->free(task->closure);
+    api->free(task);
+}
+
+static void task_complete(ws_worker_t* worker, ws_task_t* task, int run_join) {
+    ws_pool_t* pool = worker->pool;
+
+    while (task) {
+        if (run_join && task->join) task->join(task);
+
+        ws_task_t* parent = task->parent;
+        task_delete(pool->api, task);
+        worker->executed++;
+        series_sampler_add(&worker->sampler, 1);
+
+        if (!parent) {
+            atomic_store_explicit(&pool->job_done, 1, memory_order_release);
+            return;
+        }
+        if (atomic_fetch_sub_explicit(&parent->pending, 1, memory_order_acq_rel) != 1) return;
+
+        task = parent;
+        run_join = 1;
+    }
+}
+
+static void task_execute(ws_worker_t* worker, ws_task_t* task) {
+    /* After run returns non-zero the task may already be completed and freed
+     * by whichever worker finished its last child. */
+    if (task->run(worker, task) == 0) task_complete(worker, task, 0);
+}
+
+static void task_spawn(ws_worker_t* worker, ws_task_t* task) {
+    if (!deque_push(&worker->deque, task)) task_execute(worker, task);
+}
+
+/* Allocates both children before publishing either, so a failed allocation
+ * can turn the parent into a leaf without any child running. */
+static int spawn_pair(ws_worker_t* worker, ws_task_t* parent, ws_task_t* left, ws_task_t* right) {
+    allocator_api_t* api = worker->pool->api;
+    if (!left || !right) {
+        if (left) task_delete(api, left);
+        if (right) task_delete(api, right);
+        worker->failures++;
+        return 0;
+    }
+
+    atomic_store_explicit(&parent->pending, 2, memory_order_relaxed);
+    task_spawn(worker, right);
+    task_spawn(worker, left);
+    return 2;
+}
+
+static ws_task_t* find_work(ws_worker_t* worker) {
+    ws_pool_t* pool = worker->pool;
+
+    ws_task_t* task = deque_take(&worker->deque);
+    if (task) return task;
+
+    for (int attempt = 0; attempt < pool->worker_count; attempt++) {
+        int victim = (int)(xorshift32(&worker->seed) % (unsigned)pool->worker_count);
+        if (victim == worker->index) continue;
+        task = deque_steal(&pool->workers[victim].deque);
+        if (task) {
+            worker->steals++;
+            return task;
+        }
+    }
+
+    if (atomic_load_explicit(&pool->inject, memory_order_relaxed)) {
+        return atomic_exchange_explicit(&pool->inject, NULL, memory_order_acquire);
+    }
+    return NULL;
+}
+
+static THREAD_FUNC worker_func(THREAD_ARG arg) {
+    ws_worker_t* worker = (ws_worker_t*)arg;
+    ws_pool_t* pool = worker->pool;
+
+    if (!start_barrier_wait(pool->start_barrier)) thread_return();
+
+    while (!atomic_load_explicit(&pool->shutdown, memory_order_acquire)) {
+        ws_task_t* task = find_work(worker);
+        if (task)
+            task_execute(worker, task);
+        else
+            thread_yield();
+    }
+
+    series_sampler_finish(&worker->sampler);
+    thread_return();
+}
+
+typedef struct {
+    int n;
+    long long* out;
+    long long left;
+    long long right;
+} fib_closure_t;
+
+static int fib_run(ws_worker_t* worker, ws_task_t* task);
+
+static void fib_join(ws_task_t* task) {
+    fib_closure_t* c = task->closure;
+    *c->out = c->left + c->right;
+}
+
+static ws_task_t* fib_new(allocator_api_t* api, ws_task_t* parent, int n, long long* out) {
+    ws_task_t* task = task_new(api, fib_run, fib_join, parent, sizeof(fib_closure_t));
+    if (!task) return NULL;
+    fib_closure_t* c = task->closure;
+    c->n = n;
+    c->out = out;
+    return task;
+}
+
+static int fib_run(ws_worker_t* worker, ws_task_t* task) {
+    fib_closure_t* c = task->closure;
+    if (c->n < 2) {
+        *c->out = c->n;
+        return 0;
+    }
+
+    allocator_api_t* api = worker->pool->api;
+    return spawn_pair(worker, task,
+                      fib_new(api, task, c->n - 1, &c->left),
+                      fib_new(api, task, c->n - 2, &c->right));
+}
+
+typedef struct {
+    const long long* data;
+    size_t lo;
+    size_t hi;
+    size_t grain;
+    long long* out;
+    long long left;
+    long long right;
+} reduce_closure_t;
+
+static int reduce_run(ws_worker_t* worker, ws_task_t* task);
+
+static void reduce_join(ws_task_t* task) {
+    reduce_closure_t* c = task->closure;
+    *c->out = c->left + c->right;
+}
+
+static ws_task_t* reduce_new(allocator_api_t* api, ws_task_t* parent, const long long* data,
+                             size_t lo, size_t hi, size_t grain, long long* out) {
+    ws_task_t* task = task_new(api, reduce_run, reduce_join, parent, sizeof(reduce_closure_t));
+    if (!task) return NULL;
+    reduce_closure_t* c = task->closure;
+    c->data = data;
+    c->lo = lo;
+    c->hi = hi;
+    c->grain = grain;
+    c->out = out;
+    return task;
+}
+
+static int reduce_run(ws_worker_t* worker, ws_task_t* task) {
+    reduce_closure_t* c = task->closure;
+    if (c->hi - c->lo <= c->grain) {
+        long long sum = 0;
+        for (size_t i = c->lo; i < c->hi; i++) sum += c->data[i];
+        *c->out = sum;
+        return 0;
+    }
+
+    allocator_api_t* api = worker->pool->api;
+    size_t mid = c->lo + (c->hi - c->lo) / 2;
+    return spawn_pair(worker, task,
+                      reduce_new(api, task, c->data, c->lo, mid, c->grain, &c->left),
+                      reduce_new(api, task, c->data, mid, c->hi, c->grain, &c->right));
+}
+
+static size_t count_fib_tasks(int n) {
+    size_t prev = 1, current = 1;
+    for (int i = 2; i <= n; i++) {
+        size_t next = 1 + current + prev;
+        prev = current;
+        current = next;
+    }
+    return current;
+}
+
+static size_t count_reduce_tasks(size_t count, size_t grain) {
+    if (count <= grain) return 1;
+    size_t half = count / 2;
+    return 1 + count_reduce_tasks(half, grain) + count_reduce_tasks(count - half, grain);
+}
+
+typedef enum {
+    WS_JOB_FIB,
+    WS_JOB_REDUCE
+} ws_job_kind_t;
+
+static int run_pool(allocator_api_t* api, benchmark_result_t* result,
+                    benchmark_config_t* cfg, ws_job_kind_t kind) {
+    int worker_count = cfg->thread_count < 1 ? 1 : cfg->thread_count;
+    int fib_n = (int)benchmark_param_size(cfg, "fib_n", 25);
+    size_t leaves = benchmark_param_size(cfg, "reduce_size", 1 << 20);
+    size_t grain = benchmark_param_size(cfg, "grain", 16);
+    if (fib_n < 1) fib_n = 1;
+    if (fib_n > 60) fib_n = 60;
+    if (leaves < 1) leaves = 1;
+    if (grain < 1) grain = 1;
+
+    long long expected = 0;
+    long long* data = NULL;
+    if (kind == WS_JOB_FIB) {
+        long long a = 0, b = 1;
+        for (int i = 0; i < fib_n; i++) {
+            long long next = a + b;
+            a = b;
+            b = next;
+        }
+        expected = a;
+    } else {
+        data = malloc(leaves * sizeof(long long));
+        if (!data) return -1;
+        unsigned int seed = cfg->seed;
+        for (size_t i = 0; i < leaves; i++) {
+            data[i] = xorshift32(&seed) % 1000;
+            expected += data[i];
+        }
+    }
+
+    THREAD_TYPE* threads = malloc(worker_count * sizeof(THREAD_TYPE));
+    ws_worker_t* workers = calloc(worker_count, sizeof(ws_worker_t));
+    if (!threads || !workers) {
+        free(threads);
+        free(workers);
+        free(data);
+        return -1;
+    }
+
+    start_barrier_t start_barrier;
+    start_barrier_init(&start_barrier);
+
+    ws_pool_t pool;
+    pool.api = api;
+    pool.workers = workers;
+    pool.worker_count = worker_count;
+    pool.start_barrier = &start_barrier;
+    atomic_init(&pool.inject, NULL);
+    atomic_init(&pool.job_done, 0);
+    atomic_init(&pool.shutdown, 0);
+
+    int ok = 1;
+    for (int i = 0; i < worker_count; i++) {
+        workers[i].pool = &pool;
+        workers[i].index = i;
+        workers[i].seed = cfg->seed + i * 12345;
+        if (deque_init(&workers[i].deque, WS_DEQUE_CAPACITY) != 0) ok = 0;
+    }
+    if (!ok) {
+        for (int i = 0; i < worker_count; i++) deque_destroy(&workers[i].deque);
+        start_barrier_destroy(&start_barrier);
+        free(threads);
+        free(workers);
+        free(data);
+        return -1;
+    }
+
+    /* Repeat whole jobs until at least cfg->iterations tasks have run. */
+    size_t tasks_per_job = kind == WS_JOB_FIB ? count_fib_tasks(fib_n)
+                                              : count_reduce_tasks(leaves, grain);
+    size_t job_count = (cfg->iterations + tasks_per_job - 1) / tasks_per_job;
+    if (job_count < 1) job_count = 1;
+
+    int started = 0;
+    while (started < worker_count &&
+           thread_create(&threads[started], worker_func, &workers[started]) == 0) {
+        started++;
+    }
+    if (started < worker_count) {
+        start_barrier_abort(&start_barrier);
+        for (int i = 0; i < started; i++) thread_join(threads[i]);
+        for (int i = 0; i < worker_count; i++) deque_destroy(&workers[i].deque);
+        start_barrier_destroy(&start_barrier);
+        free(threads);
+        free(workers);
+        free(data);
+        return -1;
+    }
+    start_barrier_release(&start_barrier, started);
+
+    /* The clock starts once every worker is running, so spawn cost stays out
+     * of tasks/sec. Workers only touch their sampler when executing a task,
+     * and the first task is published after this. */
+    double start_ns = timer_now_ns();
+    for (int i = 0; i < worker_count; i++) {
+        series_sampler_init_at(&workers[i].sampler, &workers[i].series,
+                               cfg->sample_interval_ms, start_ns);
+    }
+
+    size_t jobs = 0;
+    while (ok && jobs < job_count) {
+        long long answer = -1;
+        ws_task_t* root = kind == WS_JOB_FIB
+            ? fib_new(api, NULL, fib_n, &answer)
+            : reduce_new(api, NULL, data, 0, leaves, grain, &answer);
+        if (!root) {
+            ok = 0;
+            break;
+        }
+
+        atomic_store_explicit(&pool.job_done, 0, memory_order_relaxed);
+        atomic_store_explicit(&pool.inject, root, memory_order_release);
+        while (!atomic_load_explicit(&pool.job_done, memory_order_acquire)) {
+            thread_yield();
+        }
+
+        if (answer != expected) ok = 0;
+        jobs++;
+    }
+    double total_time_ns = timer_now_ns() - start_ns;
+
+    atomic_store_explicit(&pool.shutdown, 1, memory_order_release);
+    for (int i = 0; i < worker_count; i++) {
+        thread_join(threads[i]);
+    }
+    start_barrier_destroy(&start_barrier);
+
+    size_t tasks = 0, steals = 0, failures = 0;
+    for (int i = 0; i < worker_count; i++) {
+        tasks += workers[i].executed;
+        steals += workers[i].steals;
+        failures += workers[i].failures;
+        series_merge(&result->throughput_series, &workers[i].series);
+        deque_destroy(&workers[i].deque);
+    }
+
+    free(threads);
+    free(workers);
+    free(data);
+
+    if (!ok || failures > 0 || tasks != jobs * tasks_per_job) return -1;
+
+    size_t closure_size = kind == WS_JOB_FIB ? sizeof(fib_closure_t) : sizeof(reduce_closure_t);
+
+    /* Every task is two allocations (task + closure) and two frees. */
+    result->operations_count = tasks * 4;
+    result->thread_count = worker_count;
+    result->alloc_ops_per_sec = (double)(tasks * 2) / (total_time_ns / 1e9);
+    result->free_ops_per_sec = result->alloc_ops_per_sec;
+    result->total_ops_per_sec = (double)result->operations_count / (total_time_ns / 1e9);
+    result->avg_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->total_time_ms = total_time_ns / 1e6;
+    result->total_requested_bytes = tasks * (sizeof(ws_task_t) + closure_size);
+    result->total_allocated_bytes = result->total_requested_bytes;
+    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+    benchmark_result_add_metric(result, "tasks_per_sec", (double)tasks / (total_time_ns / 1e9));
+    benchmark_result_add_metric(result, "jobs", (double)jobs);
+    benchmark_result_add_metric(result, "tasks_per_job", (double)tasks / (double)jobs);
+    benchmark_result_add_metric(result, "steal_fraction", (double)steals / (double)tasks);
+
+    return 0;
+}
+
+int bench_ws_fib(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+    return run_pool(api, result, cfg, WS_JOB_FIB);
+}
+
+int bench_ws_reduce(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &default_config;
+    return run_pool(api, result, cfg, WS_JOB_REDUCE);
+}
+
+void register_work_stealing_benchmarks(void) {
+    benchmark_register_thread_sweep("ws_fib", "Work-stealing fork-join fib", bench_ws_fib, 2);
+    benchmark_register_thread_sweep("ws_reduce", "Work-stealing fork-join tree reduce",
+                                    bench_ws_reduce, 2);
+}
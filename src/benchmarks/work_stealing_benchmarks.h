@@ -0,0 +1,11 @@
+#ifndef WORK_STEALING_BENCHMARKS_H
+#define WORK_STEALING_BENCHMARKS_H
+
+#include "../benchmark.h"
+
+void register_work_stealing_benchmarks(void);
+
+int bench_ws_fib(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_ws_reduce(allocator_api_t* api, benchmark_result_t* result, void* config);
+
+#endif
@@ -0,0 +1,1116 @@
+#include "workload_benchmarks.h"
+#include "timer.h"
+#include "memory_stats.h"
+#include "latency.h"
+#include "timeseries.h"
+#include "threading.h"
+#include "size_dist.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define SERVER_MAX_LARGE 8
+#define SERVER_RSS_SAMPLES 1024
+
+/* Request-sized objects: headers, strings, parsed fields. */
+static benchmark_config_t server_config = {
+    .iterations = 1000000,
+    .min_size = 16,
+    .max_size = 512,
+    .thread_count = 4,
+    .seed = 42,
+    .sample_interval_ms = 0,
+    .params = NULL,
+    .size_dist = NULL
+};
+
+static benchmark_config_t json_config = BENCHMARK_DEFAULT_CONFIG;
+static benchmark_config_t bursty_config = BENCHMARK_DEFAULT_CONFIG;
+
+static unsigned int xorshift32(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+void register_workload_benchmarks(void) {
+    static benchmark_t bench1 = {
+        .name = "server_requests",
+        .description = "Request-scoped arenas: many in-flight requests per thread, freed at request end",
+        .run = bench_server_requests,
+        .default_config = &server_config
+    };
+    benchmark_register(&bench1);
+
+    static benchmark_t bench2 = {
+        .name = "json_dom",
+        .description = "Parse synthetic JSON into a DOM (strings, realloc'd arrays, hashed objects), walk, free",
+        .run = bench_json_dom,
+        .default_config = &json_config
+    };
+    benchmark_register(&bench2);
+
+    static benchmark_t bench3 = {
+        .name = "bursty_idle",
+        .description = "Allocation bursts separated by idle sleeps (decay/purge cost, RSS over time)",
+        .run = bench_bursty_idle,
+        .default_config = &bursty_config
+    };
+    benchmark_register(&bench3);
+}
+
+typedef struct {
+    void** objects;
+    size_t target;
+    size_t count;
+    void* large[SERVER_MAX_LARGE];
+    int large_count;
+    double alloc_ns;
+} server_request_t;
+
+typedef struct {
+    size_t objects_min;
+    size_t objects_max;
+    size_t batch;
+    double large_fraction;
+    int large_max_count;
+    size_t large_min;
+    size_t large_max;
+} server_mix_t;
+
+typedef struct {
+    allocator_api_t* api;
+    const size_dist_t* dist;
+    const server_mix_t* mix;
+    size_t requests;
+    size_t inflight;
+    unsigned int seed;
+    int sample_rss;
+    start_barrier_t* start_barrier;
+    double start_ns;
+    double end_ns;
+    double alloc_time_ns;       /* mallocs only; request_lat also covers frees */
+    size_t alloc_count;
+    size_t free_count;
+    size_t completed;
+    size_t objects;
+    latency_recorder_t request_lat;
+    size_t rss_samples[SERVER_RSS_SAMPLES];
+    int rss_sample_count;
+    int failed;
+} server_thread_args_t;
+
+static void server_request_reset(server_thread_args_t* args, server_request_t* req) {
+    const server_mix_t* mix = args->mix;
+    req->target = mix->objects_min + xorshift32(&args->seed) % (mix->objects_max - mix->objects_min + 1);
+    req->count = 0;
+    req->large_count = 0;
+    req->alloc_ns = 0;
+}
+
+static int server_request_start(server_thread_args_t* args, server_request_t* req) {
+    const server_mix_t* mix = args->mix;
+    allocator_api_t* api = args->api;
+    hr_timer_t timer;
+
+    if (mix->large_max_count < 1 || xorshift32(&args->seed) % 10000 >= mix->large_fraction * 10000) return 0;
+
+    int count = 1 + (int)(xorshift32(&args->seed) % (unsigned)mix->large_max_count);
+    for (int i = 0; i < count; i++) {
+        size_t size = mix->large_min + xorshift32(&args->seed) % (mix->large_max - mix->large_min + 1);
+
+        hr_timer_init(&timer);
+        hr_timer_start(&timer);
+        void* ptr = api->malloc(size);
+        double elapsed = hr_timer_end(&timer);
+        req->alloc_ns += elapsed;
+        args->alloc_time_ns += elapsed;
+        if (!ptr) return -1;
+
+        memset(ptr, 0x42, size);
+        req->large[req->large_count++] = ptr;
+        args->alloc_count++;
+    }
+    return 0;
+}
+
+static void server_request_finish(server_thread_args_t* args, server_request_t* req) {
+    allocator_api_t* api = args->api;
+    hr_timer_t timer;
+
+    hr_timer_init(&timer);
+    hr_timer_start(&timer);
+    for (size_t i = 0; i < req->count; i++) api->free(req->objects[i]);
+    for (int i = 0; i < req->large_count; i++) api->free(req->large[i]);
+    req->alloc_ns += hr_timer_end(&timer);
+
+    args->free_count += req->count + req->large_count;
+}
+
+/* Each thread interleaves inflight requests, advancing a random one by a
+ * batch of objects at a time, the way an event loop works on many
+ * connections. A request frees everything it owns when it completes. */
+static THREAD_FUNC server_thread_func(THREAD_ARG arg) {
+    server_thread_args_t* args = (server_thread_args_t*)arg;
+    allocator_api_t* api = args->api;
+    const server_mix_t* mix = args->mix;
+    hr_timer_t timer;
+
+    server_request_t* reqs = calloc(args->inflight, sizeof(server_request_t));
+    int ok = reqs != NULL;
+    for (size_t r = 0; ok && r < args->inflight; r++) {
+        reqs[r].objects = malloc(mix->objects_max * sizeof(void*));
+        if (!reqs[r].objects) ok = 0;
+        else server_request_reset(args, &reqs[r]);
+    }
+
+    if (!start_barrier_wait(args->start_barrier)) ok = 0;
+    args->start_ns = timer_now_ns();
+
+    size_t sample_every = args->requests / SERVER_RSS_SAMPLES + 1;
+
+    while (ok && args->completed < args->requests) {
+        server_request_t* req = &reqs[xorshift32(&args->seed) % args->inflight];
+
+        if (req->count == 0 && req->large_count == 0 && server_request_start(args, req) != 0) {
+            ok = 0;
+            break;
+        }
+
+        size_t batch = req->target - req->count;
+        if (batch > mix->batch) batch = mix->batch;
+
+        for (size_t i = 0; i < batch; i++) {
+            size_t size = size_dist_sample(args->dist, &args->seed);
+
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            char* ptr = api->malloc(size);
+            double elapsed = hr_timer_end(&timer);
+            req->alloc_ns += elapsed;
+            args->alloc_time_ns += elapsed;
+            if (!ptr) {
+                ok = 0;
+                break;
+            }
+
+            memset(ptr, (int)size, size < 32 ? size : 32);
+            req->objects[req->count++] = ptr;
+            args->alloc_count++;
+        }
+        if (!ok) break;
+
+        if (req->count == req->target) {
+            server_request_finish(args, req);
+            latency_recorder_add(&args->request_lat, req->alloc_ns);
+            args->objects += req->count;
+            args->completed++;
+            server_request_reset(args, req);
+
+            if (args->sample_rss && args->completed % sample_every == 0 &&
+                args->rss_sample_count < SERVER_RSS_SAMPLES) {
+                args->rss_samples[args->rss_sample_count++] = memory_stats_sample();
+            }
+        }
+    }
+
+    args->end_ns = timer_now_ns();
+
+    for (size_t r = 0; reqs && r < args->inflight; r++) {
+        if (!reqs[r].objects) continue;
+        server_request_finish(args, &reqs[r]);
+        free(reqs[r].objects);
+    }
+    free(reqs);
+
+    args->failed = !ok;
+    thread_return();
+}
+
+int bench_server_requests(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &server_config;
+
+    int thread_count = (int)benchmark_param_size(cfg, "threads", (size_t)cfg->thread_count);
+    size_t inflight = benchmark_param_size(cfg, "inflight", 16);
+    server_mix_t mix = {
+        .objects_min = benchmark_param_size(cfg, "objects_min", 50),
+        .objects_max = benchmark_param_size(cfg, "objects_max", 500),
+        .batch = benchmark_param_size(cfg, "batch", 16),
+        .large_fraction = benchmark_param_double(cfg, "large_fraction", 0.25),
+        .large_max_count = (int)benchmark_param_size(cfg, "large_count", 3),
+        .large_min = benchmark_param_size(cfg, "large_min", 16 * 1024),
+        .large_max = benchmark_param_size(cfg, "large_max", 256 * 1024)
+    };
+    if (thread_count < 1) thread_count = 1;
+    if (inflight < 1) inflight = 1;
+    if (mix.objects_min < 1) mix.objects_min = 1;
+    if (mix.objects_max < mix.objects_min) mix.objects_max = mix.objects_min;
+    if (mix.batch < 1) mix.batch = 1;
+    if (mix.large_max_count > SERVER_MAX_LARGE) mix.large_max_count = SERVER_MAX_LARGE;
+    if (mix.large_max < mix.large_min) mix.large_max = mix.large_min;
+
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
+
+    /* Sized so the default run makes about one allocation per iteration. */
+    double mean_objects = (mix.objects_min + mix.objects_max) / 2.0;
+    size_t requests = benchmark_param_size(cfg, "requests", (size_t)(cfg->iterations / mean_objects));
+    size_t requests_per_thread = requests / thread_count;
+    if (requests_per_thread < 1) requests_per_thread = 1;
+
+    THREAD_TYPE* threads = malloc(thread_count * sizeof(THREAD_TYPE));
+    server_thread_args_t* args = calloc(thread_count, sizeof(server_thread_args_t));
+    if (!threads || !args) {
+        free(threads);
+        free(args);
+        return -1;
+    }
+
+    start_barrier_t start_barrier;
+    start_barrier_init(&start_barrier);
+
+    int ok = 1;
+    for (int i = 0; i < thread_count; i++) {
+        args[i].api = api;
+        args[i].dist = &dist;
+        args[i].mix = &mix;
+        args[i].requests = requests_per_thread;
+        args[i].inflight = inflight;
+        args[i].seed = cfg->seed + i * 12345;
+        args[i].sample_rss = i == 0;
+        args[i].start_barrier = &start_barrier;
+        if (latency_recorder_init(&args[i].request_lat, 16384) != 0) ok = 0;
+    }
+
+    if (ok) {
+        int started = 0;
+        while (started < thread_count &&
+               thread_create(&threads[started], server_thread_func, &args[started]) == 0) {
+            started++;
+        }
+        if (started < thread_count) {
+            start_barrier_abort(&start_barrier);
+            ok = 0;
+        } else {
+            start_barrier_release(&start_barrier, started);
+        }
+        for (int i = 0; i < started; i++) {
+            thread_join(threads[i]);
+        }
+    }
+    start_barrier_destroy(&start_barrier);
+
+    latency_recorder_t request_lat;
+    if (ok && latency_recorder_init(&request_lat, 65536) != 0) ok = 0;
+
+    if (ok) {
+        double first_start_ns = args[0].start_ns;
+        double last_end_ns = args[0].end_ns;
+        double alloc_time_ns = 0;
+        size_t allocs = 0, frees = 0, completed = 0, objects = 0;
+
+        for (int i = 0; i < thread_count; i++) {
+            if (args[i].failed) ok = 0;
+            if (args[i].start_ns < first_start_ns) first_start_ns = args[i].start_ns;
+            if (args[i].end_ns > last_end_ns) last_end_ns = args[i].end_ns;
+            alloc_time_ns += args[i].alloc_time_ns;
+            allocs += args[i].alloc_count;
+            frees += args[i].free_count;
+            completed += args[i].completed;
+            objects += args[i].objects;
+            latency_recorder_merge(&request_lat, &args[i].request_lat);
+        }
+
+        /* Steady state: the second half of thread 0's samples. */
+        int samples = args[0].rss_sample_count;
+        double steady_rss = 0;
+        for (int s = samples / 2; s < samples; s++) steady_rss += (double)args[0].rss_samples[s];
+        if (samples - samples / 2 > 0) steady_rss /= samples - samples / 2;
+
+        double total_time_ns = last_end_ns - first_start_ns;
+
+        result->operations_count = allocs + frees;
+        result->thread_count = thread_count;
+        result->alloc_ops_per_sec = (double)allocs / (total_time_ns / 1e9);
+        result->free_ops_per_sec = (double)frees / (total_time_ns / 1e9);
+        result->total_ops_per_sec = (double)result->operations_count / (total_time_ns / 1e9);
+        result->avg_alloc_time_ns = allocs ? alloc_time_ns / allocs : BENCHMARK_METRIC_NA;
+        result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->total_requested_bytes = (size_t)(objects * dist.mean_size);
+        result->total_allocated_bytes = result->total_requested_bytes;
+        result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+        benchmark_result_add_metric(result, "requests_per_sec", completed / (total_time_ns / 1e9));
+        benchmark_result_add_metric(result, "request_alloc_avg_ns", latency_recorder_mean(&request_lat));
+        benchmark_result_add_metric(result, "request_alloc_p50_ns", latency_recorder_percentile(&request_lat, 0.50));
+        benchmark_result_add_metric(result, "request_alloc_p99_ns", latency_recorder_percentile(&request_lat, 0.99));
+        benchmark_result_add_metric(result, "objects_per_request", completed ? (double)objects / completed : 0);
+        benchmark_result_add_metric(result, "inflight_requests", (double)(inflight * thread_count));
+        benchmark_result_add_metric(result, "steady_rss_kb", samples ? steady_rss : BENCHMARK_METRIC_NA);
+
+        latency_recorder_destroy(&request_lat);
+    }
+
+    for (int i = 0; i < thread_count; i++) {
+        latency_recorder_destroy(&args[i].request_lat);
+    }
+    free(threads);
+    free(args);
+
+    return ok ? 0 : -1;
+}
+
+typedef enum {
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+} json_type_t;
+
+typedef struct json_value json_value_t;
+
+typedef struct {
+    char* key;
+    size_t key_len;
+    uint32_t hash;
+    json_value_t* value;
+} json_member_t;
+
+struct json_value {
+    json_type_t type;
+    union {
+        double number;
+        int boolean;
+        struct {
+            char* ptr;
+            size_t len;
+        } string;
+        struct {
+            json_value_t** items;
+            size_t count;
+            size_t capacity;
+        } array;
+        struct {
+            json_member_t* slots;
+            size_t count;
+            size_t capacity;
+        } object;
+    } u;
+};
+
+typedef struct {
+    allocator_api_t* api;
+    const char* p;
+    size_t allocs;
+    size_t frees;
+    int failed;
+} json_parser_t;
+
+/* Synthetic documents: a libc-backed text buffer the generator appends to. */
+typedef struct {
+    char* data;
+    size_t len;
+    size_t capacity;
+    unsigned int seed;
+} json_text_t;
+
+static const char* json_words[] = {
+    "id", "name", "type", "value", "items", "created_at", "updated_at", "user",
+    "email", "tags", "status", "description", "url", "count", "price", "enabled",
+    "metadata", "region", "score", "children", "parent", "title", "body", "version"
+};
+#define JSON_WORD_COUNT (sizeof(json_words) / sizeof(json_words[0]))
+
+static void text_append(json_text_t* text, const char* str, size_t len) {
+    if (text->len + len + 1 > text->capacity) {
+        size_t capacity = text->capacity ? text->capacity * 2 : 4096;
+        while (capacity < text->len + len + 1) capacity *= 2;
+        char* data = realloc(text->data, capacity);
+        if (!data) return;
+        text->data = data;
+        text->capacity = capacity;
+    }
+    memcpy(text->data + text->len, str, len);
+    text->len += len;
+    text->data[text->len] = '\0';
+}
+
+static void text_puts(json_text_t* text, const char* str) {
+    text_append(text, str, strlen(str));
+}
+
+static void gen_string(json_text_t* text) {
+    char buf[64];
+    size_t len = 3 + xorshift32(&text->seed) % 40;
+    size_t pos = 0;
+    buf[pos++] = '"';
+    for (size_t i = 0; i < len; i++) {
+        unsigned int r = xorshift32(&text->seed) % 64;
+        if (r == 0) {
+            buf[pos++] = '\\';
+            buf[pos++] = 'n';
+        } else if (r == 1) {
+            buf[pos++] = '\\';
+            buf[pos++] = '"';
+        } else {
+            buf[pos++] = (char)('a' + r % 26);
+        }
+        if (pos >= sizeof(buf) - 3) break;
+    }
+    buf[pos++] = '"';
+    text_append(text, buf, pos);
+}
+
+static void gen_value(json_text_t* text, int depth);
+
+static void gen_object(json_text_t* text, int depth, size_t members) {
+    text_puts(text, "{");
+    for (size_t i = 0; i < members; i++) {
+        if (i > 0) text_puts(text, ",");
+        text_puts(text, "\"");
+        text_puts(text, json_words[xorshift32(&text->seed) % JSON_WORD_COUNT]);
+        if (xorshift32(&text->seed) % 2) {
+            char suffix[16];
+            snprintf(suffix, sizeof(suffix), "_%u", xorshift32(&text->seed) % 100);
+            text_puts(text, suffix);
+        }
+        text_puts(text, "\":");
+        gen_value(text, depth + 1);
+    }
+    text_puts(text, "}");
+}
+
+static void gen_value(json_text_t* text, int depth) {
+    unsigned int kind = xorshift32(&text->seed) % 10;
+    if (depth >= 5 && kind >= 7) kind = 3;
+
+    char buf[32];
+    switch (kind) {
+        case 0:
+            text_puts(text, (xorshift32(&text->seed) % 3) ? "true" : (xorshift32(&text->seed) % 2 ? "false" : "null"));
+            break;
+        case 1:
+        case 2:
+            snprintf(buf, sizeof(buf), "%u", xorshift32(&text->seed) % 100000);
+            text_puts(text, buf);
+            break;
+        case 3:
+        case 4:
+        case 5:
+        case 6:
+            gen_string(text);
+            break;
+        case 7:
+        case 8: {
+            size_t count = xorshift32(&text->seed) % 24;
+            text_puts(text, "[");
+            for (size_t i = 0; i < count; i++) {
+                if (i > 0) text_puts(text, ",");
+                gen_value(text, depth + 1);
+            }
+            text_puts(text, "]");
+            break;
+        }
+        default:
+            gen_object(text, depth, 1 + xorshift32(&text->seed) % 10);
+            break;
+    }
+}
+
+/* A top-level array of records, appended to until it reaches target bytes. */
+static int gen_document(json_text_t* text, size_t target) {
+    text->len = 0;
+    text_puts(text, "[");
+    for (size_t i = 0; text->len < target; i++) {
+        if (i > 0) text_puts(text, ",");
+        gen_object(text, 1, 4 + xorshift32(&text->seed) % 8);
+    }
+    text_puts(text, "]");
+    return text->data ? 0 : -1;
+}
+
+static uint32_t json_hash(const char* key, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)key[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void* json_alloc(json_parser_t* parser, size_t size) {
+    void* ptr = parser->api->malloc(size);
+    if (!ptr) parser->failed = 1;
+    else parser->allocs++;
+    return ptr;
+}
+
+static void json_free(json_parser_t* parser, void* ptr) {
+    if (!ptr) return;
+    parser->api->free(ptr);
+    parser->frees++;
+}
+
+static void skip_ws(json_parser_t* parser) {
+    while (*parser->p == ' ' || *parser->p == '\n' || *parser->p == '\t' || *parser->p == '\r') parser->p++;
+}
+
+static char* parse_string_raw(json_parser_t* parser, size_t* out_len) {
+    const char* start = ++parser->p;
+    size_t len = 0;
+    const char* s = start;
+    while (*s && *s != '"') {
+        if (*s == '\\' && s[1]) s++;
+        s++;
+        len++;
+    }
+    if (*s != '"') {
+        parser->failed = 1;
+        return NULL;
+    }
+
+    char* str = json_alloc(parser, len + 1);
+    if (!str) return NULL;
+
+    size_t pos = 0;
+    for (s = start; *s != '"'; s++) {
+        if (*s == '\\') {
+            s++;
+            switch (*s) {
+                case 'n': str[pos++] = '\n'; break;
+                case 't': str[pos++] = '\t'; break;
+                case 'r': str[pos++] = '\r'; break;
+                case 'b': str[pos++] = '\b'; break;
+                case 'f': str[pos++] = '\f'; break;
+                case 'u': str[pos++] = '?'; s += 4; break;
+                default: str[pos++] = *s; break;
+            }
+        } else {
+            str[pos++] = *s;
+        }
+    }
+    str[pos] = '\0';
+    parser->p = s + 1;
+    *out_len = pos;
+    return str;
+}
+
+static json_value_t* parse_value(json_parser_t* parser);
+static void json_destroy(json_parser_t* parser, json_value_t* value);
+
+static int array_push(json_parser_t* parser, json_value_t* array, json_value_t* item) {
+    if (array->u.array.count == array->u.array.capacity) {
+        size_t capacity = array->u.array.capacity ? array->u.array.capacity * 2 : 4;
+        json_value_t** items = parser->api->realloc(array->u.array.items, capacity * sizeof(json_value_t*));
+        if (!items) {
+            parser->failed = 1;
+            return -1;
+        }
+        if (!array->u.array.items) parser->allocs++;
+        array->u.array.items = items;
+        array->u.array.capacity = capacity;
+    }
+    array->u.array.items[array->u.array.count++] = item;
+    return 0;
+}
+
+static json_member_t* object_find_slot(json_member_t* slots, size_t capacity, const char* key,
+                                       size_t len, uint32_t hash) {
+    size_t mask = capacity - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        json_member_t* slot = &slots[i];
+        if (!slot->key) return slot;
+        if (slot->hash == hash && slot->key_len == len && memcmp(slot->key, key, len) == 0) return slot;
+    }
+}
+
+/* Open addressing, kept at most 3/4 full; grown tables are calloc'd fresh. */
+static int object_put(json_parser_t* parser, json_value_t* object, char* key, size_t len,
+                      json_value_t* value) {
+    if ((object->u.object.count + 1) * 4 > object->u.object.capacity * 3) {
+        size_t capacity = object->u.object.capacity ? object->u.object.capacity * 2 : 8;
+        json_member_t* slots = parser->api->calloc(capacity, sizeof(json_member_t));
+        if (!slots) {
+            parser->failed = 1;
+            return -1;
+        }
+        parser->allocs++;
+        for (size_t i = 0; i < object->u.object.capacity; i++) {
+            json_member_t* old = &object->u.object.slots[i];
+            if (old->key) *object_find_slot(slots, capacity, old->key, old->key_len, old->hash) = *old;
+        }
+        json_free(parser, object->u.object.slots);
+        object->u.object.slots = slots;
+        object->u.object.capacity = capacity;
+    }
+
+    uint32_t hash = json_hash(key, len);
+    json_member_t* slot = object_find_slot(object->u.object.slots, object->u.object.capacity, key, len, hash);
+    if (slot->key) {
+        /* Duplicate key: the last one wins, as in most parsers. */
+        json_free(parser, key);
+        json_destroy(parser, slot->value);
+        slot->value = value;
+        return 0;
+    }
+    slot->key = key;
+    slot->key_len = len;
+    slot->hash = hash;
+    slot->value = value;
+    object->u.object.count++;
+    return 0;
+}
+
+static json_value_t* parse_value(json_parser_t* parser) {
+    skip_ws(parser);
+
+    json_value_t* value = json_alloc(parser, sizeof(json_value_t));
+    if (!value) return NULL;
+    memset(value, 0, sizeof(json_value_t));
+
+    char c = *parser->p;
+    if (c == '{') {
+        value->type = JSON_OBJECT;
+        parser->p++;
+        skip_ws(parser);
+        if (*parser->p == '}') {
+            parser->p++;
+            return value;
+        }
+        while (!parser->failed) {
+            skip_ws(parser);
+            if (*parser->p != '"') {
+                parser->failed = 1;
+                break;
+            }
+            size_t len = 0;
+            char* key = parse_string_raw(parser, &len);
+            if (!key) break;
+            skip_ws(parser);
+            if (*parser->p != ':') {
+                json_free(parser, key);
+                parser->failed = 1;
+                break;
+            }
+            parser->p++;
+            json_value_t* member = parse_value(parser);
+            if (!member || object_put(parser, value, key, len, member) != 0) {
+                json_free(parser, key);
+                json_destroy(parser, member);
+                break;
+            }
+            skip_ws(parser);
+            if (*parser->p == ',') {
+                parser->p++;
+            } else if (*parser->p == '}') {
+                parser->p++;
+                break;
+            } else {
+                parser->failed = 1;
+            }
+        }
+    } else if (c == '[') {
+        value->type = JSON_ARRAY;
+        parser->p++;
+        skip_ws(parser);
+        if (*parser->p == ']') {
+            parser->p++;
+            return value;
+        }
+        while (!parser->failed) {
+            json_value_t* item = parse_value(parser);
+            if (!item || array_push(parser, value, item) != 0) {
+                json_destroy(parser, item);
+                break;
+            }
+            skip_ws(parser);
+            if (*parser->p == ',') {
+                parser->p++;
+            } else if (*parser->p == ']') {
+                parser->p++;
+                break;
+            } else {
+                parser->failed = 1;
+            }
+        }
+    } else if (c == '"') {
+        value->type = JSON_STRING;
+        value->u.string.ptr = parse_string_raw(parser, &value->u.string.len);
+    } else if (c == 't' && strncmp(parser->p, "true", 4) == 0) {
+        value->type = JSON_BOOL;
+        value->u.boolean = 1;
+        parser->p += 4;
+    } else if (c == 'f' && strncmp(parser->p, "false", 5) == 0) {
+        value->type = JSON_BOOL;
+        parser->p += 5;
+    } else if (c == 'n' && strncmp(parser->p, "null", 4) == 0) {
+        value->type = JSON_NULL;
+        parser->p += 4;
+    } else {
+        char* end = NULL;
+        value->type = JSON_NUMBER;
+        value->u.number = strtod(parser->p, &end);
+        if (end == parser->p) parser->failed = 1;
+        else parser->p = end;
+    }
+
+    if (parser->failed) {
+        json_destroy(parser, value);
+        return NULL;
+    }
+    return value;
+}
+
+static void json_destroy(json_parser_t* parser, json_value_t* value) {
+    if (!value) return;
+
+    switch (value->type) {
+        case JSON_STRING:
+            json_free(parser, value->u.string.ptr);
+            break;
+        case JSON_ARRAY:
+            for (size_t i = 0; i < value->u.array.count; i++) json_destroy(parser, value->u.array.items[i]);
+            json_free(parser, value->u.array.items);
+            break;
+        case JSON_OBJECT:
+            for (size_t i = 0; i < value->u.object.capacity; i++) {
+                json_member_t* slot = &value->u.object.slots[i];
+                if (!slot->key) continue;
+                json_free(parser, slot->key);
+                json_destroy(parser, slot->value);
+            }
+            json_free(parser, value->u.object.slots);
+            break;
+        default:
+            break;
+    }
+    json_free(parser, value);
+}
+
+/* Visits every node and looks every object member up by key, the access
+ * pattern of code that consumes a parsed document. */
+static uint64_t json_walk(const json_value_t* value, size_t* nodes) {
+    (*nodes)++;
+    switch (value->type) {
+        case JSON_BOOL: return (uint64_t)value->u.boolean;
+        case JSON_NUMBER: return (uint64_t)value->u.number;
+        case JSON_STRING: return value->u.string.len + (unsigned char)value->u.string.ptr[0];
+        case JSON_ARRAY: {
+            uint64_t sum = value->u.array.count;
+            for (size_t i = 0; i < value->u.array.count; i++) sum += json_walk(value->u.array.items[i], nodes);
+            return sum;
+        }
+        case JSON_OBJECT: {
+            uint64_t sum = value->u.object.count;
+            for (size_t i = 0; i < value->u.object.capacity; i++) {
+                const json_member_t* slot = &value->u.object.slots[i];
+                if (!slot->key) continue;
+                const json_member_t* found = object_find_slot(value->u.object.slots, value->u.object.capacity,
+                                                              slot->key, slot->key_len, slot->hash);
+                sum += json_walk(found->value, nodes);
+            }
+            return sum;
+        }
+        default:
+            return 0;
+    }
+}
+
+int bench_json_dom(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &json_config;
+
+    size_t doc_bytes = benchmark_param_size(cfg, "doc_kb", 64) * 1024;
+    size_t pool_size = benchmark_param_size(cfg, "doc_pool", 8);
+    if (doc_bytes < 64) doc_bytes = 64;
+    if (pool_size < 1) pool_size = 1;
+
+    /* Roughly one allocation per 20 bytes of text, so the default run makes
+     * about as many allocations as the other benchmarks' iteration count. */
+    size_t docs = benchmark_param_size(cfg, "docs", cfg->iterations * 20 / doc_bytes);
+    if (docs < 1) docs = 1;
+
+    json_text_t* pool = calloc(pool_size, sizeof(json_text_t));
+    if (!pool) return -1;
+
+    int ok = 1;
+    size_t text_bytes = 0;
+    for (size_t d = 0; d < pool_size && ok; d++) {
+        pool[d].seed = cfg->seed + (unsigned int)d * 7919;
+        if (gen_document(&pool[d], doc_bytes) != 0) ok = 0;
+    }
+
+    json_parser_t parser = { .api = api };
+    double parse_ns = 0, walk_ns = 0, free_ns = 0;
+    uint64_t checksum = 0;
+    size_t nodes = 0;
+    size_t live_allocs_peak = 0;
+
+    for (size_t d = 0; d < docs && ok; d++) {
+        json_text_t* text = &pool[d % pool_size];
+        parser.p = text->data;
+        parser.failed = 0;
+
+        size_t allocs_before = parser.allocs;
+        size_t frees_before = parser.frees;
+
+        double t0 = timer_now_ns();
+        json_value_t* root = parse_value(&parser);
+        double t1 = timer_now_ns();
+        if (!root || parser.failed) {
+            ok = 0;
+            break;
+        }
+
+        checksum += json_walk(root, &nodes);
+        double t2 = timer_now_ns();
+
+        size_t live = (parser.allocs - allocs_before) - (parser.frees - frees_before);
+        if (live > live_allocs_peak) live_allocs_peak = live;
+        /* Sampled while the DOM is live, outside every timed window. */
+        if (d % 16 == 0) memory_stats_sample();
+
+        double t3 = timer_now_ns();
+        json_destroy(&parser, root);
+        double t4 = timer_now_ns();
+
+        parse_ns += t1 - t0;
+        walk_ns += t2 - t1;
+        free_ns += t4 - t3;
+        text_bytes += text->len;
+    }
+
+    for (size_t d = 0; d < pool_size; d++) free(pool[d].data);
+    free(pool);
+
+    if (!ok) return -1;
+
+    double total_ns = parse_ns + walk_ns + free_ns;
+
+    result->operations_count = parser.allocs + parser.frees;
+    result->thread_count = 1;
+    result->alloc_ops_per_sec = (double)parser.allocs / (parse_ns / 1e9);
+    result->free_ops_per_sec = (double)parser.frees / (free_ns / 1e9);
+    result->total_ops_per_sec = (double)result->operations_count / (total_ns / 1e9);
+    result->avg_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p50_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->p99_alloc_time_ns = BENCHMARK_METRIC_NA;
+    result->total_requested_bytes = text_bytes;
+    result->total_allocated_bytes = text_bytes;
+    result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+    benchmark_result_add_metric(result, "docs_per_sec", docs / (total_ns / 1e9));
+    benchmark_result_add_metric(result, "mb_per_sec", text_bytes / (1024.0 * 1024.0) / (total_ns / 1e9));
+    benchmark_result_add_metric(result, "allocs_per_doc", (double)parser.allocs / docs);
+    benchmark_result_add_metric(result, "nodes_per_doc", (double)nodes / docs);
+    benchmark_result_add_metric(result, "parse_us_per_doc", parse_ns / docs / 1e3);
+    benchmark_result_add_metric(result, "walk_us_per_doc", walk_ns / docs / 1e3);
+    benchmark_result_add_metric(result, "free_us_per_doc", free_ns / docs / 1e3);
+    benchmark_result_add_metric(result, "peak_live_allocs", (double)live_allocs_peak);
+    benchmark_do_not_optimize(checksum);
+
+    return 0;
+}
+
+/* RSS at the end of each fixed wall-clock slice, polled from both the
+ * burst loop and the idle sleeps. */
+typedef struct {
+    benchmark_series_t* series;
+    double next_ns;
+} rss_sampler_t;
+
+static void rss_sampler_poll(rss_sampler_t* sampler, double now_ns) {
+    while (now_ns >= sampler->next_ns) {
+        series_push_value(sampler->series, (float)memory_stats_sample());
+        sampler->next_ns += sampler->series->interval_ms * 1e6;
+    }
+}
+
+int bench_bursty_idle(allocator_api_t* api, benchmark_result_t* result, void* config) {
+    benchmark_config_t* cfg = config ? (benchmark_config_t*)config : &bursty_config;
+
+    size_t bursts = benchmark_param_size(cfg, "bursts", 6);
+    double idle_ms = benchmark_param_double(cfg, "idle_ms", 250);
+    size_t slots = benchmark_param_size(cfg, "slots", 65536);
+    double keep_fraction = benchmark_param_double(cfg, "keep_fraction", 0.05);
+    size_t first_n = benchmark_param_size(cfg, "first_n", 1000);
+    double rss_ms = benchmark_param_double(cfg, "rss_ms",
+                                           cfg->sample_interval_ms > 0 ? cfg->sample_interval_ms : 5);
+    if (bursts < 2) bursts = 2;
+    if (slots < 1) slots = 1;
+    if (idle_ms < 0) idle_ms = 0;
+    if (rss_ms < 1) rss_ms = 1;
+    size_t burst_ops = benchmark_param_size(cfg, "burst_ops", cfg->iterations / bursts);
+    if (burst_ops < 1) burst_ops = 1;
+
+    size_dist_t dist;
+    if (size_dist_init(&dist, cfg->size_dist, cfg->min_size, cfg->max_size) != 0) return -1;
+
+    void** ptrs = calloc(slots, sizeof(void*));
+    latency_recorder_t post_idle_lat, warm_lat;
+    memset(&post_idle_lat, 0, sizeof(post_idle_lat));
+    memset(&warm_lat, 0, sizeof(warm_lat));
+    if (!ptrs || latency_recorder_init(&post_idle_lat, 65536) != 0 ||
+        latency_recorder_init(&warm_lat, 65536) != 0) {
+        free(ptrs);
+        latency_recorder_destroy(&post_idle_lat);
+        latency_recorder_destroy(&warm_lat);
+        return -1;
+    }
+
+    unsigned int seed = cfg->seed;
+    unsigned int keep_threshold = (unsigned int)(keep_fraction * 65536.0);
+    hr_timer_t timer;
+    double alloc_ns = 0, free_ns = 0;
+    size_t alloc_count = 0, free_count = 0;
+    size_t total_requested = 0;
+    int ok = 1;
+
+    double burst_rss_sum = 0, idle_start_rss_sum = 0, idle_end_rss_sum = 0;
+    double idle_wall_ns = 0, idle_bg_cpu_ns = 0;
+    size_t post_idle_faults = 0;
+    int idles = 0;
+
+    rss_sampler_t rss;
+    rss.series = &result->rss_series;
+    memset(rss.series, 0, sizeof(benchmark_series_t));
+    rss.series->interval_ms = rss_ms;
+    rss.next_ns = timer_now_ns() + rss_ms * 1e6;
+
+    for (size_t burst = 0; burst < bursts && ok; burst++) {
+        size_t faults_before = get_page_faults();
+
+        for (size_t op = 0; op < burst_ops; op++) {
+            size_t slot = xorshift32(&seed) % slots;
+            if (ptrs[slot]) {
+                hr_timer_init(&timer);
+                hr_timer_start(&timer);
+                api->free(ptrs[slot]);
+                free_ns += hr_timer_end(&timer);
+                free_count++;
+                ptrs[slot] = NULL;
+            }
+
+            size_t size = size_dist_sample(&dist, &seed);
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            ptrs[slot] = api->malloc(size);
+            double elapsed = hr_timer_end(&timer);
+            if (!ptrs[slot]) {
+                ok = 0;
+                break;
+            }
+            memset(ptrs[slot], (int)op, size < 64 ? size : 64);
+            alloc_ns += elapsed;
+            alloc_count++;
+            total_requested += size;
+
+            /* The first allocations of a burst after an idle gap are the ones
+             * that pay for memory the allocator released while idle. */
+            if (op < first_n) {
+                if (burst > 0) latency_recorder_add(&post_idle_lat, elapsed);
+                if (op + 1 == first_n && burst > 0) post_idle_faults += get_page_faults() - faults_before;
+            } else {
+                latency_recorder_add(&warm_lat, elapsed);
+            }
+
+            if ((op & 255) == 0) rss_sampler_poll(&rss, timer_now_ns());
+        }
+        if (!ok || burst + 1 == bursts) break;
+
+        burst_rss_sum += (double)memory_stats_sample();
+
+        /* Most of the burst's memory becomes garbage before the gap. */
+        for (size_t i = 0; i < slots; i++) {
+            if (!ptrs[i] || (xorshift32(&seed) & 0xFFFF) < keep_threshold) continue;
+            hr_timer_init(&timer);
+            hr_timer_start(&timer);
+            api->free(ptrs[i]);
+            free_ns += hr_timer_end(&timer);
+            free_count++;
+            ptrs[i] = NULL;
+        }
+
+        /* Anything the process burns while this thread sleeps belongs to
+         * background threads (decay, purging, stats). */
+        double idle_start = timer_now_ns();
+        double process_cpu = timer_process_cpu_ns();
+        double thread_cpu = timer_thread_cpu_ns();
+        idle_start_rss_sum += (double)memory_stats_sample();
+
+        double idle_ns = idle_ms * 1e6;
+        double now = idle_start;
+        while (now - idle_start < idle_ns) {
+            double step_ns = idle_ns - (now - idle_start);
+            if (step_ns > rss_ms * 1e6) step_ns = rss_ms * 1e6;
+            thread_sleep_us((unsigned int)(step_ns / 1000.0) + 1);
+            now = timer_now_ns();
+            rss_sampler_poll(&rss, now);
+        }
+
+        idle_end_rss_sum += (double)memory_stats_sample();
+        idle_bg_cpu_ns += (timer_process_cpu_ns() - process_cpu) - (timer_thread_cpu_ns() - thread_cpu);
+        idle_wall_ns += timer_now_ns() - idle_start;
+        idles++;
+    }
+    rss_sampler_poll(&rss, timer_now_ns());
+
+    for (size_t i = 0; i < slots; i++) {
+        if (ptrs[i]) api->free(ptrs[i]);
+    }
+    free(ptrs);
+
+    if (ok) {
+        double post_idle_mean = latency_recorder_mean(&post_idle_lat);
+        double warm_mean = latency_recorder_mean(&warm_lat);
+
+        result->operations_count = alloc_count + free_count;
+        result->thread_count = 1;
+        result->alloc_ops_per_sec = (double)alloc_count / (alloc_ns / 1e9);
+        result->free_ops_per_sec = (double)free_count / (free_ns / 1e9);
+        result->total_ops_per_sec = (double)result->operations_count / ((alloc_ns + free_ns) / 1e9);
+        result->avg_alloc_time_ns = alloc_ns / alloc_count;
+        result->min_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->max_alloc_time_ns = BENCHMARK_METRIC_NA;
+        result->p50_alloc_time_ns = latency_recorder_percentile(&warm_lat, 0.50);
+        result->p99_alloc_time_ns = latency_recorder_percentile(&warm_lat, 0.99);
+        result->total_requested_bytes = total_requested;
+        result->total_allocated_bytes = total_requested;
+        result->fragmentation_ratio = BENCHMARK_METRIC_NA;
+
+        benchmark_result_add_metric(result, "bursts", (double)bursts);
+        benchmark_result_add_metric(result, "idle_ms", idles ? idle_wall_ns / idles / 1e6 : 0);
+        benchmark_result_add_metric(result, "first_n", (double)first_n);
+        benchmark_result_add_metric(result, "post_idle_avg_ns", post_idle_mean);
+        benchmark_result_add_metric(result, "post_idle_p50_ns", latency_recorder_percentile(&post_idle_lat, 0.50));
+        benchmark_result_add_metric(result, "post_idle_p99_ns", latency_recorder_percentile(&post_idle_lat, 0.99));
+        benchmark_result_add_metric(result, "post_idle_max_ns", post_idle_lat.max);
+        benchmark_result_add_metric(result, "warm_avg_ns", warm_mean);
+        benchmark_result_add_metric(result, "post_idle_slowdown",
+                                    warm_mean > 0 ? post_idle_mean / warm_mean : BENCHMARK_METRIC_NA);
+        benchmark_result_add_metric(result, "post_idle_faults", (double)post_idle_faults / (bursts - 1));
+        benchmark_result_add_metric(result, "burst_rss_kb", idles ? burst_rss_sum / idles : BENCHMARK_METRIC_NA);
+        benchmark_result_add_metric(result, "idle_start_rss_kb", idles ? idle_start_rss_sum / idles : BENCHMARK_METRIC_NA);
+        benchmark_result_add_metric(result, "idle_end_rss_kb", idles ? idle_end_rss_sum / idles : BENCHMARK_METRIC_NA);
+        benchmark_result_add_metric(result, "idle_released_kb",
+                                    idles ? (idle_start_rss_sum - idle_end_rss_sum) / idles : BENCHMARK_METRIC_NA);
+        benchmark_result_add_metric(result, "bg_cpu_ms_per_idle", idles ? idle_bg_cpu_ns / idles / 1e6 : 0);
+        benchmark_result_add_metric(result, "bg_cpu_fraction",
+                                    idle_wall_ns > 0 ? idle_bg_cpu_ns / idle_wall_ns : 0);
+    }
+
+    latency_recorder_destroy(&post_idle_lat);
+    latency_recorder_destroy(&warm_lat);
+
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,12 @@
+#ifndef WORKLOAD_BENCHMARKS_H
+#define WORKLOAD_BENCHMARKS_H
+
+#include "../benchmark.h"
+
+void register_workload_benchmarks(void);
+
+int bench_server_requests(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_json_dom(allocator_api_t* api, benchmark_result_t* result, void* config);
+int bench_bursty_idle(allocator_api_t* api, benchmark_result_t* result, void* config);
+
+#endif
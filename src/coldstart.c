@@ -0,0 +1,103 @@
+/* Minimal process for the cold_start benchmark: exec'd fresh for every run so
+ * the allocator's initialization and first allocations are measured from a
+ * clean address space. Each allocator gets its own binary that links only
+ * that allocator, named by COLDSTART_ALLOCATOR_INIT at build time, so no other
+ * allocator's constructors or binary size show up in its numbers;
+ * allocbench_coldstart_none has no allocator and is the bare baseline.
+ *
+ * Usage: allocbench_coldstart_<allocator|none> <count> <min_size> <max_size> <exec_ns>
+ *
+ * count is capped at COLDSTART_MAX_COUNT; the report ends with the number of
+ * blocks actually allocated (0 for the bare binary).
+ *
+ * exec_ns is the parent's timer_now_ns() taken just before execv. Nothing in
+ * here may call into libc's malloc before the first timed allocation, so
+ * arguments are parsed with strtoull and the report is written with write(2).
+ * After reporting, the process frees everything and blocks on stdin so the
+ * parent can read its idle footprint from /proc. */
+
+#include "allocator_api.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#define COLDSTART_MAX_COUNT 100000
+
+static unsigned int xorshift32(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static long page_faults(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return usage.ru_minflt + usage.ru_majflt;
+}
+
+/* Returns 1 when this binary has an allocator, 0 for the bare one. */
+static int select_allocator(allocator_api_t* api) {
+#ifdef COLDSTART_ALLOCATOR_INIT
+    COLDSTART_ALLOCATOR_INIT(api);
+    return 1;
+#else
+    memset(api, 0, sizeof(*api));
+    return 0;
+#endif
+}
+
+static void* blocks[COLDSTART_MAX_COUNT];
+
+int main(int argc, char** argv) {
+    double main_ns = timer_now_ns();
+    long faults_before = page_faults();
+
+    if (argc != 5) return 2;
+    size_t count = (size_t)strtoull(argv[1], NULL, 10);
+    size_t min_size = (size_t)strtoull(argv[2], NULL, 10);
+    size_t max_size = (size_t)strtoull(argv[3], NULL, 10);
+    double exec_ns = (double)strtoull(argv[4], NULL, 10);
+    if (count > COLDSTART_MAX_COUNT) count = COLDSTART_MAX_COUNT;
+    if (min_size < 1) min_size = 1;
+    if (max_size < min_size) max_size = min_size;
+
+    allocator_api_t api;
+    int bare = !select_allocator(&api);
+    if (!bare && !api.malloc) return 3;
+
+    double first_ns = main_ns, last_ns = main_ns;
+    unsigned int seed = 42;
+    if (!bare && count > 0) {
+        if (api.init) api.init();
+        for (size_t i = 0; i < count; i++) {
+            size_t size = min_size + xorshift32(&seed) % (max_size - min_size + 1);
+            blocks[i] = api.malloc(size);
+            if (!blocks[i]) return 4;
+            if (i == 0) first_ns = timer_now_ns();
+        }
+        last_ns = timer_now_ns();
+    }
+    long faults = page_faults() - faults_before;
+
+    if (!bare) {
+        for (size_t i = 0; i < count; i++) api.free(blocks[i]);
+    }
+
+    char line[256];
+    int len = snprintf(line, sizeof(line), "%.0f %.0f %.0f %ld %zu\n",
+                       main_ns - exec_ns, first_ns - exec_ns, last_ns - exec_ns, faults,
+                       bare ? (size_t)0 : count);
+    if (write(STDOUT_FILENO, line, (size_t)len) != len) return 5;
+
+    char byte;
+    while (read(STDIN_FILENO, &byte, 1) > 0) {}
+
+    if (!bare && api.cleanup) api.cleanup();
+    return 0;
+}
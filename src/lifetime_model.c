@@ -0,0 +1,126 @@
+#include "lifetime_model.h"
+#include <math.h>
+#include <stdlib.h>
+
+static unsigned int xorshift32(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static double uniform01(unsigned int* state) {
+    /* (0, 1]: keeps log() finite. */
+    return ((double)xorshift32(state) + 1.0) / 4294967296.0;
+}
+
+static uint64_t sample_exponential(double mean, unsigned int* state) {
+    double value = -mean * log(uniform01(state));
+    return value < 1.0 ? 1 : (uint64_t)value;
+}
+
+void lifetime_model_fixed(lifetime_model_t* model, uint64_t lifetime) {
+    model->kind = LIFETIME_FIXED;
+    model->mean = lifetime < 1 ? 1.0 : (double)lifetime;
+    model->young_fraction = 1.0;
+    model->young_mean = model->mean;
+    model->old_mean = model->mean;
+}
+
+void lifetime_model_exponential(lifetime_model_t* model, double mean) {
+    model->kind = LIFETIME_EXPONENTIAL;
+    model->mean = mean < 1.0 ? 1.0 : mean;
+    model->young_fraction = 1.0;
+    model->young_mean = model->mean;
+    model->old_mean = model->mean;
+}
+
+void lifetime_model_generational(lifetime_model_t* model, double young_fraction,
+                                 double young_mean, double old_mean) {
+    if (young_fraction < 0.0) young_fraction = 0.0;
+    if (young_fraction > 1.0) young_fraction = 1.0;
+
+    model->kind = LIFETIME_GENERATIONAL;
+    model->young_fraction = young_fraction;
+    model->young_mean = young_mean < 1.0 ? 1.0 : young_mean;
+    model->old_mean = old_mean < 1.0 ? 1.0 : old_mean;
+    model->mean = young_fraction * model->young_mean + (1.0 - young_fraction) * model->old_mean;
+}
+
+uint64_t lifetime_model_sample(const lifetime_model_t* model, unsigned int* state) {
+    switch (model->kind) {
+        case LIFETIME_FIXED:
+            return (uint64_t)model->mean;
+        case LIFETIME_EXPONENTIAL:
+            return sample_exponential(model->mean, state);
+        case LIFETIME_GENERATIONAL:
+            if (uniform01(state) <= model->young_fraction)
+                return sample_exponential(model->young_mean, state);
+            return sample_exponential(model->old_mean, state);
+    }
+    return 1;
+}
+
+double lifetime_model_mean(const lifetime_model_t* model) {
+    return model->mean;
+}
+
+int expiry_queue_init(expiry_queue_t* queue, size_t capacity) {
+    if (capacity < 16) capacity = 16;
+    queue->entries = malloc(capacity * sizeof(expiry_entry_t));
+    if (!queue->entries) return -1;
+    queue->count = 0;
+    queue->capacity = capacity;
+    return 0;
+}
+
+void expiry_queue_destroy(expiry_queue_t* queue) {
+    free(queue->entries);
+    queue->entries = NULL;
+    queue->count = 0;
+    queue->capacity = 0;
+}
+
+int expiry_queue_push(expiry_queue_t* queue, uint64_t expiry, void* ptr, size_t size) {
+    if (queue->count == queue->capacity) {
+        size_t new_capacity = queue->capacity * 2;
+        expiry_entry_t* entries = realloc(queue->entries, new_capacity * sizeof(expiry_entry_t));
+        if (!entries) return -1;
+        queue->entries = entries;
+        queue->capacity = new_capacity;
+    }
+
+    size_t i = queue->count++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (queue->entries[parent].expiry <= expiry) break;
+        queue->entries[i] = queue->entries[parent];
+        i = parent;
+    }
+    queue->entries[i].expiry = expiry;
+    queue->entries[i].ptr = ptr;
+    queue->entries[i].size = size;
+    return 0;
+}
+
+int expiry_queue_pop_expired(expiry_queue_t* queue, uint64_t now, expiry_entry_t* out) {
+    if (queue->count == 0 || queue->entries[0].expiry > now) return 0;
+
+    *out = queue->entries[0];
+    expiry_entry_t last = queue->entries[--queue->count];
+
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= queue->count) break;
+        if (child + 1 < queue->count && queue->entries[child + 1].expiry < queue->entries[child].expiry)
+            child++;
+        if (last.expiry <= queue->entries[child].expiry) break;
+        queue->entries[i] = queue->entries[child];
+        i = child;
+    }
+    if (queue->count > 0) queue->entries[i] = last;
+    return 1;
+}
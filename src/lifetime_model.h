@@ -0,0 +1,54 @@
+#ifndef LIFETIME_MODEL_H
+#define LIFETIME_MODEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Object lifetimes measured in allocations: an object allocated at clock t
+ * with lifetime L is freed once the clock reaches t + L. */
+typedef enum {
+    LIFETIME_FIXED,
+    LIFETIME_EXPONENTIAL,
+    LIFETIME_GENERATIONAL
+} lifetime_kind_t;
+
+typedef struct {
+    lifetime_kind_t kind;
+    double mean;
+    double young_fraction;
+    double young_mean;
+    double old_mean;
+} lifetime_model_t;
+
+void lifetime_model_fixed(lifetime_model_t* model, uint64_t lifetime);
+void lifetime_model_exponential(lifetime_model_t* model, double mean);
+
+/* Most objects die young (exponential, young_mean); the rest are drawn from
+ * a much longer exponential and effectively live for the whole run. */
+void lifetime_model_generational(lifetime_model_t* model, double young_fraction,
+                                 double young_mean, double old_mean);
+
+uint64_t lifetime_model_sample(const lifetime_model_t* model, unsigned int* state);
+double lifetime_model_mean(const lifetime_model_t* model);
+
+typedef struct {
+    uint64_t expiry;
+    void* ptr;
+    size_t size;
+} expiry_entry_t;
+
+/* Binary min-heap on expiry time. */
+typedef struct {
+    expiry_entry_t* entries;
+    size_t count;
+    size_t capacity;
+} expiry_queue_t;
+
+int expiry_queue_init(expiry_queue_t* queue, size_t capacity);
+void expiry_queue_destroy(expiry_queue_t* queue);
+int expiry_queue_push(expiry_queue_t* queue, uint64_t expiry, void* ptr, size_t size);
+
+/* Pops the earliest entry if it expires at or before now. */
+int expiry_queue_pop_expired(expiry_queue_t* queue, uint64_t now, expiry_entry_t* out);
+
+#endif
@@ -1,10 +1,16 @@
 #include "benchmark.h"
 #include "allocator_api.h"
 #include "memory_stats.h"
+#include "system_info.h"
+#include "size_dist.h"
 #include "micro_benchmarks.h"
 #include "data_structure_benchmarks.h"
 #include "threaded_benchmarks.h"
 #include "fragmentation_benchmarks.h"
+#include "work_stealing_benchmarks.h"
+#include "large_benchmarks.h"
+#include "workload_benchmarks.h"
+#include "process_benchmarks.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -27,6 +33,10 @@ static void register_all_benchmarks(void) {
     register_data_structure_benchmarks();
     register_threaded_benchmarks();
     register_fragmentation_benchmarks();
+    register_work_stealing_benchmarks();
+    register_large_benchmarks();
+    register_workload_benchmarks();
+    register_process_benchmarks();
 }
 
 static void register_all_allocators(void) {
@@ -71,8 +81,15 @@ static void print_usage(const char* program) {
     printf("  -a <name>               Run benchmarks for specific allocator\n");
     printf("  -b <name>               Run specific benchmark\n");
     printf("  -o <dir>                Output directory for results (default: results)\n");
-    printf("  -i <count>              Number of iterations (default: 1000000)\n");
+    printf("  -i <count>              Number of iterations (default: per benchmark)\n");
     printf("  --graph                 Benchmark across multiple iteration counts\n");
+    printf("  -p <key=value,...>      Benchmark parameters (e.g. producers=4,queue_depth=256)\n");
+    printf("  --timeseries <ms>       Record throughput per <ms> time slice\n");
+    printf("  --touch <mode>          Write to every returned block inside the timed call:\n");
+    printf("                          none (default), first-line or full\n");
+    printf("  --size-dist <spec>      Allocation size distribution, e.g. loguniform:8-64K,\n");
+    printf("                          zipf:16-4096:1.2, bimodal:16-64:4K-16K:0.9,\n");
+    printf("                          discrete:16=50,64=30,256=20, file:sizes.txt\n");
     printf("\n");
 }
 
@@ -93,12 +110,16 @@ static void list_benchmarks_and_allocators(void) {
 static void write_graph_json(const char* filepath, const char* benchmark_name,
                              const char** allocator_names, int num_allocators,
                              const size_t* iteration_counts, int num_iterations,
-                             benchmark_result_t** results) {
+                             benchmark_result_t** results, const system_info_t* system) {
     FILE* fp = fopen(filepath, "w");
     if (!fp) return;
 
     fprintf(fp, "{\n");
     fprintf(fp, "  \"mode\": \"graph\",\n");
+    fprintf(fp, "  \"touch\": \"%s\",\n", touch_mode_name(benchmark_get_options()->touch));
+    fprintf(fp, "  \"system\": ");
+    system_info_write_json(fp, system, "  ");
+    fprintf(fp, ",\n");
     fprintf(fp, "  \"benchmark\": \"%s\",\n", benchmark_name);
     fprintf(fp, "  \"iterations\": [");
     for (int i = 0; i < num_iterations; i++) {
@@ -116,9 +137,9 @@ static void write_graph_json(const char* filepath, const char* benchmark_name,
 
     const char* metric_names[] = {
         "total_ops_per_sec", "alloc_ops_per_sec", "free_ops_per_sec",
-        "avg_alloc_time_ns", "peak_rss_kb"
+        "avg_alloc_time_ns", "peak_rss_kb", "page_faults"
     };
-    int num_metrics = 5;
+    int num_metrics = 6;
 
     for (int m = 0; m < num_metrics; m++) {
         fprintf(fp, "    \"%s\": {\n", metric_names[m]);
@@ -140,6 +161,8 @@ static void write_graph_json(const char* filepath, const char* benchmark_name,
                     value = r->avg_alloc_time_ns;
                 else if (strcmp(metric_names[m], "peak_rss_kb") == 0)
                     value = (double)r->peak_rss_kb;
+                else if (strcmp(metric_names[m], "page_faults") == 0)
+                    value = (double)r->page_faults;
 
                 fprintf(fp, "%.2f%s", value, (i < num_iterations - 1) ? ", " : "");
             }
@@ -175,6 +198,11 @@ static int run_graph_mode(const char* output_dir, const char* specific_benchmark
     }
 
     printf("\n--- allocbench: graph mode\n\n");
+
+    system_info_t system;
+    system_info_collect(&system);
+    if (system_info_print_warnings(&system) > 0) printf("\n");
+
     printf("Iteration counts: ");
     for (int i = 0; i < NUM_GRAPH_ITERATIONS; i++) {
         printf("%zu%s", GRAPH_ITERATIONS[i], (i < NUM_GRAPH_ITERATIONS - 1) ? ", " : "\n");
@@ -207,13 +235,9 @@ static int run_graph_mode(const char* output_dir, const char* specific_benchmark
         printf("\n");
 
         for (int i = 0; i < NUM_GRAPH_ITERATIONS; i++) {
-            benchmark_config_t config = {
-                .iterations = GRAPH_ITERATIONS[i],
-                .min_size = 8,
-                .max_size = 4096,
-                .thread_count = 1,
-                .seed = 42
-            };
+            benchmark_config_t config;
+            benchmark_make_config(bench, &config);
+            config.iterations = GRAPH_ITERATIONS[i];
 
             printf("%-12zu", GRAPH_ITERATIONS[i]);
 
@@ -229,8 +253,15 @@ static int run_graph_mode(const char* output_dir, const char* specific_benchmark
                 benchmark_config_t* old_config = bench->default_config;
                 bench->default_config = &config;
 
+                allocator_api_t api;
+                touch_api_wrap(&api, &alloc->api, benchmark_get_options()->touch);
+
+                memset(&results[a][i], 0, sizeof(benchmark_result_t));
+                benchmark_purge_allocators();
                 memory_stats_reset();
-                int ret = bench->run(&alloc->api, &results[a][i], &config);
+                size_t faults_before = get_page_faults();
+                int ret = bench->run(&api, &results[a][i], &config);
+                results[a][i].page_faults = get_page_faults() - faults_before;
                 memory_stats_get(&results[a][i].peak_rss_kb, &results[a][i].current_rss_kb);
 
                 bench->default_config = old_config;
@@ -248,7 +279,7 @@ static int run_graph_mode(const char* output_dir, const char* specific_benchmark
         char filepath[512];
         snprintf(filepath, sizeof(filepath), "%s/graph_%s.json", output_dir, bench->name);
         write_graph_json(filepath, bench->name, allocator_names, num_allocators,
-                        GRAPH_ITERATIONS, NUM_GRAPH_ITERATIONS, results);
+                        GRAPH_ITERATIONS, NUM_GRAPH_ITERATIONS, results, &system);
         printf("\nSaved: %s\n", filepath);
 
         for (int a = 0; a < num_allocators; a++) {
@@ -263,7 +294,11 @@ int main(int argc, char** argv) {
     const char* output_dir = "results";
     const char* specific_allocator = NULL;
     const char* specific_benchmark = NULL;
-    size_t iterations = 1000000;
+    size_t iterations = 0;
+    double sample_interval_ms = 0;
+    const char* params = NULL;
+    const char* size_dist = NULL;
+    touch_mode_t touch = TOUCH_NONE;
     int graph_mode = 0;
 
     for (int i = 1; i < argc; i++) {
@@ -293,12 +328,49 @@ int main(int argc, char** argv) {
         else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
             iterations = (size_t)atoll(argv[++i]);
         }
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            params = argv[++i];
+        }
+        else if (strcmp(argv[i], "--timeseries") == 0 && i + 1 < argc) {
+            sample_interval_ms = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--size-dist") == 0 && i + 1 < argc) {
+            size_dist = argv[++i];
+        }
+        else if (strcmp(argv[i], "--touch") == 0 && i + 1 < argc) {
+            if (touch_mode_parse(argv[++i], &touch) != 0) {
+                fprintf(stderr, "Invalid touch mode: %s (expected none, first-line or full)\n", argv[i]);
+                return 1;
+            }
+        }
+    }
+
+    if (size_dist) {
+        size_dist_t dist;
+        if (size_dist_init(&dist, size_dist, 8, 4096) != 0) {
+            fprintf(stderr, "Invalid size distribution: %s\n", size_dist);
+            return 1;
+        }
+        printf("Size distribution: %s (%zu-%zu bytes, mean %.1f)\n",
+               size_dist, dist.min_size, dist.max_size, dist.mean_size);
     }
 
     benchmark_init();
     register_all_benchmarks();
     register_all_allocators();
 
+    benchmark_options_t options = {
+        .iterations = iterations,
+        .sample_interval_ms = sample_interval_ms,
+        .params = params,
+        .size_dist = size_dist,
+        .touch = touch
+    };
+    if (touch != TOUCH_NONE) {
+        printf("Touch mode: %s\n", touch_mode_name(touch));
+    }
+    benchmark_set_options(&options);
+
     memory_stats_init();
 
     if (graph_mode) {
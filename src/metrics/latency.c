@@ -0,0 +1,120 @@
+#include "latency.h"
+#include "../benchmark.h"
+#include <stdlib.h>
+#include <string.h>
+
+int latency_recorder_init(latency_recorder_t* rec, size_t capacity) {
+    memset(rec, 0, sizeof(latency_recorder_t));
+    if (capacity == 0) capacity = 1;
+
+    rec->samples = malloc(capacity * sizeof(double));
+    if (!rec->samples) return -1;
+
+    rec->capacity = capacity;
+    rec->min = 1e30;
+    rec->rng = 2463534242u;
+    return 0;
+}
+
+void latency_recorder_destroy(latency_recorder_t* rec) {
+    free(rec->samples);
+    rec->samples = NULL;
+    rec->capacity = 0;
+    rec->count = 0;
+}
+
+static unsigned int xorshift32(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static size_t random_below(latency_recorder_t* rec, size_t n) {
+    return (size_t)(((unsigned long long)xorshift32(&rec->rng) << 32 |
+                     xorshift32(&rec->rng)) % n);
+}
+
+void latency_recorder_add(latency_recorder_t* rec, double value) {
+    rec->seen++;
+    rec->total += value;
+    if (value < rec->min) rec->min = value;
+    if (value > rec->max) rec->max = value;
+
+    if (rec->count < rec->capacity) {
+        rec->samples[rec->count++] = value;
+        return;
+    }
+
+    size_t slot = random_below(rec, rec->seen);
+    if (slot < rec->capacity) rec->samples[slot] = value;
+}
+
+void latency_recorder_merge(latency_recorder_t* dst, const latency_recorder_t* src) {
+    size_t seen = dst->seen + src->seen;
+    double total = dst->total + src->total;
+    double min = src->min < dst->min ? src->min : dst->min;
+    double max = src->max > dst->max ? src->max : dst->max;
+
+    if (dst->count == dst->seen && src->count == src->seen &&
+        dst->count + src->count <= dst->capacity) {
+        /* Neither side has been sampled yet: the union is exact. */
+        memcpy(dst->samples + dst->count, src->samples, src->count * sizeof(double));
+        dst->count += src->count;
+    } else if (src->count > 0) {
+        /* Each sample stands for seen/count events on its side, so every
+         * output slot is drawn from dst or src in proportion to their seen
+         * counts, without replacement within a side. */
+        size_t dst_left = dst->count, src_left = src->count;
+        size_t n = dst_left + src_left;
+        if (n > dst->capacity) n = dst->capacity;
+
+        double* pool = malloc((dst_left + src_left) * sizeof(double));
+        if (pool) {
+            double* dst_pool = pool;
+            double* src_pool = pool + dst_left;
+            memcpy(dst_pool, dst->samples, dst_left * sizeof(double));
+            memcpy(src_pool, src->samples, src_left * sizeof(double));
+
+            for (size_t k = 0; k < n; k++) {
+                int from_src = dst_left == 0 ||
+                               (src_left > 0 && random_below(dst, seen) >= dst->seen);
+                double* side = from_src ? src_pool : dst_pool;
+                size_t* left = from_src ? &src_left : &dst_left;
+
+                size_t pick = random_below(dst, *left);
+                dst->samples[k] = side[pick];
+                side[pick] = side[--*left];
+            }
+            dst->count = n;
+            free(pool);
+        }
+    }
+
+    dst->seen = seen;
+    dst->total = total;
+    dst->min = min;
+    dst->max = max;
+}
+
+double latency_recorder_mean(const latency_recorder_t* rec) {
+    if (rec->seen == 0) return BENCHMARK_METRIC_NA;
+    return rec->total / (double)rec->seen;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double diff = *(const double*)a - *(const double*)b;
+    return (diff > 0) - (diff < 0);
+}
+
+double latency_recorder_percentile(latency_recorder_t* rec, double percentile) {
+    if (rec->count == 0) return BENCHMARK_METRIC_NA;
+
+    qsort(rec->samples, rec->count, sizeof(double), compare_doubles);
+
+    size_t index = (size_t)(rec->count * percentile);
+    if (index >= rec->count) index = rec->count - 1;
+    return rec->samples[index];
+}
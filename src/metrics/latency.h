@@ -0,0 +1,27 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stddef.h>
+
+/* Bounded latency sample set. Once full, new samples replace old ones by
+ * reservoir sampling, so percentiles stay unbiased for any run length. */
+typedef struct {
+    double* samples;
+    size_t capacity;
+    size_t count;
+    size_t seen;
+    double total;
+    double min;
+    double max;
+    unsigned int rng;
+} latency_recorder_t;
+
+int latency_recorder_init(latency_recorder_t* rec, size_t capacity);
+void latency_recorder_destroy(latency_recorder_t* rec);
+void latency_recorder_add(latency_recorder_t* rec, double value);
+void latency_recorder_merge(latency_recorder_t* dst, const latency_recorder_t* src);
+
+double latency_recorder_mean(const latency_recorder_t* rec);
+double latency_recorder_percentile(latency_recorder_t* rec, double percentile);
+
+#endif
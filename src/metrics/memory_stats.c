@@ -33,8 +33,29 @@ size_t get_peak_rss_kb(void) {
     return 0;
 }
 
+size_t get_virtual_size_kb(void) {
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return pmc.PagefileUsage / 1024;
+    }
+    return 0;
+}
+
+size_t get_anon_huge_kb(void) {
+    return 0;
+}
+
+size_t get_page_faults(void) {
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return pmc.PageFaultCount;
+    }
+    return 0;
+}
+
 #else
 #include <unistd.h>
+#include <sys/resource.h>
 #include <sys/sysinfo.h>
 
 static size_t page_size_cache = 0;
@@ -78,6 +99,43 @@ size_t get_peak_rss_kb(void) {
     fclose(fp);
     return peak_rss;
 }
+
+size_t get_virtual_size_kb(void) {
+    FILE* fp = fopen("/proc/self/statm", "r");
+    if (!fp) return 0;
+
+    unsigned long size;
+    if (fscanf(fp, "%lu", &size) != 1) {
+        fclose(fp);
+        return 0;
+    }
+    fclose(fp);
+
+    return (size * get_page_size()) / 1024;
+}
+
+size_t get_anon_huge_kb(void) {
+    FILE* fp = fopen("/proc/self/smaps_rollup", "r");
+    if (!fp) return 0;
+
+    char line[256];
+    size_t huge_kb = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        if (strncmp(line, "AnonHugePages:", 14) == 0) {
+            sscanf(line + 14, "%zu", &huge_kb);
+            break;
+        }
+    }
+
+    fclose(fp);
+    return huge_kb;
+}
+
+size_t get_page_faults(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return (size_t)usage.ru_minflt + (size_t)usage.ru_majflt;
+}
 #endif
 
 static size_t global_peak_rss = 0;
@@ -88,6 +146,9 @@ void memory_stats_init(void) {
     global_peak_rss = baseline_rss;
 }
 
+/* Callers purge the allocators first (benchmark_purge_allocators), so
+ * memory cached for earlier benchmarks does not absorb the next one's
+ * growth and hide it from RSS. */
 void memory_stats_reset(void) {
     baseline_rss = get_current_rss_kb();
     global_peak_rss = baseline_rss;
@@ -103,6 +164,16 @@ void memory_stats_get(size_t* peak_rss_kb, size_t* current_rss_kb) {
     if (current_rss_kb) *current_rss_kb = current - baseline_rss;
 }
 
+/* Records the current RSS into the running peak and returns it relative to
+ * the baseline. Call periodically from long benchmarks to catch transient peaks. */
+size_t memory_stats_sample(void) {
+    size_t current = get_current_rss_kb();
+    if (current > global_peak_rss) {
+        global_peak_rss = current;
+    }
+    return current > baseline_rss ? current - baseline_rss : 0;
+}
+
 void allocation_tracker_init(allocation_tracker_t* tracker) {
     memset(tracker, 0, sizeof(allocation_tracker_t));
 }
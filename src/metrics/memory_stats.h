@@ -6,11 +6,22 @@
 void memory_stats_init(void);
 void memory_stats_reset(void);
 void memory_stats_get(size_t* peak_rss_kb, size_t* current_rss_kb);
+size_t memory_stats_sample(void);
 
 size_t get_current_rss_kb(void);
 size_t get_peak_rss_kb(void);
+
+/* Address space the process has reserved (committed bytes on Windows). */
+size_t get_virtual_size_kb(void);
+
+/* Anonymous memory currently backed by transparent huge pages; 0 where the
+ * kernel does not report it. */
+size_t get_anon_huge_kb(void);
 size_t get_page_size(void);
 
+/* Minor plus major page faults taken by the process so far. */
+size_t get_page_faults(void);
+
 typedef struct {
     size_t total_allocated;
     size_t total_freed;
@@ -0,0 +1,59 @@
+#include "perf_counters.h"
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int perf_counter_open(perf_counter_t* counter, perf_counter_event_t event) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8);
+    if (event == PERF_COUNTER_DTLB_LOAD_MISSES)
+        attr.config |= (uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+    else
+        attr.config |= (uint64_t)PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    counter->fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    return counter->fd >= 0 ? 0 : -1;
+}
+
+void perf_counter_start(perf_counter_t* counter) {
+    if (counter->fd < 0) return;
+    ioctl(counter->fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(counter->fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+uint64_t perf_counter_stop(perf_counter_t* counter) {
+    uint64_t value = 0;
+    if (counter->fd < 0) return 0;
+    ioctl(counter->fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(counter->fd, &value, sizeof(value)) != sizeof(value)) return 0;
+    return value;
+}
+
+void perf_counter_close(perf_counter_t* counter) {
+    if (counter->fd >= 0) close(counter->fd);
+    counter->fd = -1;
+}
+
+#else
+
+int perf_counter_open(perf_counter_t* counter, perf_counter_event_t event) {
+    (void)event;
+    counter->fd = -1;
+    return -1;
+}
+
+void perf_counter_start(perf_counter_t* counter) { (void)counter; }
+uint64_t perf_counter_stop(perf_counter_t* counter) { (void)counter; return 0; }
+void perf_counter_close(perf_counter_t* counter) { counter->fd = -1; }
+
+#endif
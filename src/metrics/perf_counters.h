@@ -0,0 +1,26 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdint.h>
+
+/* Hardware event counters for the calling thread, user space only. Opening
+ * fails (and callers should report the metric as unavailable) without
+ * perf_event_open, under a restrictive perf_event_paranoid, or in VMs that
+ * expose no PMU. */
+typedef enum {
+    PERF_COUNTER_DTLB_LOADS,
+    PERF_COUNTER_DTLB_LOAD_MISSES
+} perf_counter_event_t;
+
+typedef struct {
+    int fd;
+} perf_counter_t;
+
+int perf_counter_open(perf_counter_t* counter, perf_counter_event_t event);
+void perf_counter_start(perf_counter_t* counter);
+
+/* Stops counting and returns the count since the last start. */
+uint64_t perf_counter_stop(perf_counter_t* counter);
+void perf_counter_close(perf_counter_t* counter);
+
+#endif
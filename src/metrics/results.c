@@ -16,6 +16,8 @@ void results_init(results_context_t* ctx, const char* output_dir) {
     time_t now = time(NULL);
     struct tm* tm_info = localtime(&now);
     strftime(ctx->timestamp, sizeof(ctx->timestamp), "%Y%m%d_%H%M%S", tm_info);
+
+    system_info_collect(&ctx->system);
 }
 
 void results_add_entry(results_context_t* ctx, const char* benchmark_name,
@@ -45,6 +47,22 @@ static void write_json_string(FILE* fp, const char* str) {
     fputc('"', fp);
 }
 
+static void write_json_gauge_series(FILE* fp, const benchmark_gauge_series_t* series) {
+    fprintf(fp, "{\"interval_ops\": %.0f, \"values\": [", series->interval_ops);
+    for (int i = 0; i < series->count; i++) {
+        fprintf(fp, "%.6g%s", series->values[i], (i < series->count - 1) ? ", " : "");
+    }
+    fprintf(fp, "]}");
+}
+
+static void write_json_series(FILE* fp, const benchmark_series_t* series) {
+    fprintf(fp, "{\"interval_ms\": %.3f, \"values\": [", series->interval_ms);
+    for (int i = 0; i < series->count; i++) {
+        fprintf(fp, "%.6g%s", series->values[i], (i < series->count - 1) ? ", " : "");
+    }
+    fprintf(fp, "]}");
+}
+
 int results_write_json(results_context_t* ctx, char* filepath, size_t filepath_size) {
     snprintf(filepath, filepath_size, "%s/benchmark_%s.json",
              ctx->output_dir, ctx->timestamp);
@@ -56,6 +74,10 @@ int results_write_json(results_context_t* ctx, char* filepath, size_t filepath_s
 
     fprintf(fp, "{\n");
     fprintf(fp, "  \"timestamp\": \"%s\",\n", ctx->timestamp);
+    fprintf(fp, "  \"touch\": \"%s\",\n", touch_mode_name(benchmark_get_options()->touch));
+    fprintf(fp, "  \"system\": ");
+    system_info_write_json(fp, &ctx->system, "  ");
+    fprintf(fp, ",\n");
     fprintf(fp, "  \"results\": [\n");
 
     for (int i = 0; i < ctx->count; i++) {
@@ -72,10 +94,26 @@ int results_write_json(results_context_t* ctx, char* filepath, size_t filepath_s
         fprintf(fp, "      \"metrics\": {\n");
         fprintf(fp, "        \"total_time_ms\": %.6f,\n", r->total_time_ms);
         fprintf(fp, "        \"operations\": %zu,\n", r->operations_count);
-        fprintf(fp, "        \"alloc_ops_per_sec\": %.2f,\n", r->alloc_ops_per_sec);
-        fprintf(fp, "        \"free_ops_per_sec\": %.2f,\n", r->free_ops_per_sec);
-        fprintf(fp, "        \"total_ops_per_sec\": %.2f,\n", r->total_ops_per_sec);
-        fprintf(fp, "        \"avg_alloc_time_ns\": %.2f,\n", r->avg_alloc_time_ns);
+
+        if (r->alloc_ops_per_sec == BENCHMARK_METRIC_NA)
+            fprintf(fp, "        \"alloc_ops_per_sec\": null,\n");
+        else
+            fprintf(fp, "        \"alloc_ops_per_sec\": %.2f,\n", r->alloc_ops_per_sec);
+
+        if (r->free_ops_per_sec == BENCHMARK_METRIC_NA)
+            fprintf(fp, "        \"free_ops_per_sec\": null,\n");
+        else
+            fprintf(fp, "        \"free_ops_per_sec\": %.2f,\n", r->free_ops_per_sec);
+
+        if (r->total_ops_per_sec == BENCHMARK_METRIC_NA)
+            fprintf(fp, "        \"total_ops_per_sec\": null,\n");
+        else
+            fprintf(fp, "        \"total_ops_per_sec\": %.2f,\n", r->total_ops_per_sec);
+
+        if (r->avg_alloc_time_ns == BENCHMARK_METRIC_NA)
+            fprintf(fp, "        \"avg_alloc_time_ns\": null,\n");
+        else
+            fprintf(fp, "        \"avg_alloc_time_ns\": %.2f,\n", r->avg_alloc_time_ns);
 
         if (r->min_alloc_time_ns == BENCHMARK_METRIC_NA)
             fprintf(fp, "        \"min_alloc_time_ns\": null,\n");
@@ -99,6 +137,7 @@ int results_write_json(results_context_t* ctx, char* filepath, size_t filepath_s
 
         fprintf(fp, "        \"peak_rss_kb\": %zu,\n", r->peak_rss_kb);
         fprintf(fp, "        \"current_rss_kb\": %zu,\n", r->current_rss_kb);
+        fprintf(fp, "        \"page_faults\": %zu,\n", r->page_faults);
 
         if (r->fragmentation_ratio == BENCHMARK_METRIC_NA)
             fprintf(fp, "        \"fragmentation_ratio\": null,\n");
@@ -108,7 +147,44 @@ int results_write_json(results_context_t* ctx, char* filepath, size_t filepath_s
         fprintf(fp, "        \"total_allocated_bytes\": %zu,\n", r->total_allocated_bytes);
         fprintf(fp, "        \"total_requested_bytes\": %zu,\n", r->total_requested_bytes);
         fprintf(fp, "        \"thread_count\": %d\n", r->thread_count);
-        fprintf(fp, "      }\n");
+        int has_throughput = r->throughput_series.count > 0;
+        int has_fragmentation = r->fragmentation_series.count > 0;
+        int has_rss = r->rss_series.count > 0;
+        fprintf(fp, "      }%s\n",
+                (r->extra_metric_count > 0 || has_throughput || has_fragmentation || has_rss) ? "," : "");
+
+        if (r->extra_metric_count > 0) {
+            fprintf(fp, "      \"extra\": {\n");
+            for (int m = 0; m < r->extra_metric_count; m++) {
+                fprintf(fp, "        ");
+                write_json_string(fp, r->extra_metrics[m].name);
+                if (r->extra_metrics[m].value == BENCHMARK_METRIC_NA)
+                    fprintf(fp, ": null");
+                else
+                    fprintf(fp, ": %.6g", r->extra_metrics[m].value);
+                fprintf(fp, "%s\n", (m < r->extra_metric_count - 1) ? "," : "");
+            }
+            fprintf(fp, "      }%s\n", (has_throughput || has_fragmentation || has_rss) ? "," : "");
+        }
+
+        if (has_throughput) {
+            fprintf(fp, "      \"throughput_series\": ");
+            write_json_series(fp, &r->throughput_series);
+            fprintf(fp, "%s\n", (has_fragmentation || has_rss) ? "," : "");
+        }
+
+        if (has_fragmentation) {
+            fprintf(fp, "      \"fragmentation_series\": ");
+            write_json_gauge_series(fp, &r->fragmentation_series);
+            fprintf(fp, "%s\n", has_rss ? "," : "");
+        }
+
+        if (has_rss) {
+            fprintf(fp, "      \"rss_series\": ");
+            write_json_series(fp, &r->rss_series);
+            fprintf(fp, "\n");
+        }
+
         fprintf(fp, "    }%s\n", (i < ctx->count - 1) ? "," : "");
     }
 
@@ -119,24 +195,37 @@ int results_write_json(results_context_t* ctx, char* filepath, size_t filepath_s
     return 0;
 }
 
+/* Not-applicable metrics are left as empty cells. */
+static void write_csv_metric(FILE* fp, double value, int precision) {
+    if (value == BENCHMARK_METRIC_NA)
+        fputc(',', fp);
+    else
+        fprintf(fp, ",%.*f", precision, value);
+}
+
 int results_write_csv(results_context_t* ctx, const char* filepath) {
     FILE* fp = fopen(filepath, "w");
     if (!fp) return -1;
 
     fprintf(fp, "benchmark,allocator,total_time_ms,operations,alloc_ops_per_sec,"
                 "free_ops_per_sec,total_ops_per_sec,avg_alloc_time_ns,"
-                "p99_alloc_time_ns,peak_rss_kb,fragmentation_ratio,thread_count\n");
+                "p99_alloc_time_ns,peak_rss_kb,page_faults,fragmentation_ratio,thread_count\n");
 
     for (int i = 0; i < ctx->count; i++) {
         result_entry_t* e = &ctx->entries[i];
         benchmark_result_t* r = &e->result;
 
-        fprintf(fp, "%s,%s,%.6f,%zu,%.2f,%.2f,%.2f,%.2f,%.2f,%zu,%.6f,%d\n",
+        fprintf(fp, "%s,%s,%.6f,%zu",
                 e->benchmark_name, e->allocator_name,
-                r->total_time_ms, r->operations_count,
-                r->alloc_ops_per_sec, r->free_ops_per_sec, r->total_ops_per_sec,
-                r->avg_alloc_time_ns, r->p99_alloc_time_ns,
-                r->peak_rss_kb, r->fragmentation_ratio, r->thread_count);
+                r->total_time_ms, r->operations_count);
+        write_csv_metric(fp, r->alloc_ops_per_sec, 2);
+        write_csv_metric(fp, r->free_ops_per_sec, 2);
+        write_csv_metric(fp, r->total_ops_per_sec, 2);
+        write_csv_metric(fp, r->avg_alloc_time_ns, 2);
+        write_csv_metric(fp, r->p99_alloc_time_ns, 2);
+        fprintf(fp, ",%zu,%zu", r->peak_rss_kb, r->page_faults);
+        write_csv_metric(fp, r->fragmentation_ratio, 6);
+        fprintf(fp, ",%d\n", r->thread_count);
     }
 
     fclose(fp);
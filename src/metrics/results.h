@@ -2,6 +2,7 @@
 #define RESULTS_H
 
 #include "../benchmark.h"
+#include "system_info.h"
 #include <stdio.h>
 
 #define MAX_RESULTS 1024
@@ -17,6 +18,7 @@ typedef struct {
     int count;
     char output_dir[256];
     char timestamp[32];
+    system_info_t system;
 } results_context_t;
 
 void results_init(results_context_t* ctx, const char* output_dir);
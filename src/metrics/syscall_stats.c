@@ -0,0 +1,76 @@
+#ifdef ALLOCBENCH_WRAP_SYSCALLS
+#define _GNU_SOURCE
+#endif
+
+#include "syscall_stats.h"
+#include <string.h>
+
+#ifdef ALLOCBENCH_WRAP_SYSCALLS
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+
+static atomic_size_t mmap_calls;
+static atomic_size_t munmap_calls;
+static atomic_size_t mremap_calls;
+static atomic_size_t mmap_bytes;
+static atomic_size_t munmap_bytes;
+
+void* __real_mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset);
+int __real_munmap(void* addr, size_t length);
+void* __real_mremap(void* old_address, size_t old_size, size_t new_size, int flags, ...);
+
+void* __wrap_mmap(void* addr, size_t length, int prot, int flags, int fd, off_t offset) {
+    atomic_fetch_add_explicit(&mmap_calls, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&mmap_bytes, length, memory_order_relaxed);
+    return __real_mmap(addr, length, prot, flags, fd, offset);
+}
+
+int __wrap_munmap(void* addr, size_t length) {
+    atomic_fetch_add_explicit(&munmap_calls, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&munmap_bytes, length, memory_order_relaxed);
+    return __real_munmap(addr, length);
+}
+
+void* __wrap_mremap(void* old_address, size_t old_size, size_t new_size, int flags, ...) {
+    void* new_address = NULL;
+    if (flags & MREMAP_FIXED) {
+        va_list args;
+        va_start(args, flags);
+        new_address = va_arg(args, void*);
+        va_end(args);
+    }
+
+    atomic_fetch_add_explicit(&mremap_calls, 1, memory_order_relaxed);
+    return __real_mremap(old_address, old_size, new_size, flags, new_address);
+}
+
+int syscall_stats_available(void) {
+    return 1;
+}
+
+void syscall_stats_get(syscall_stats_t* stats) {
+    stats->mmap_calls = atomic_load_explicit(&mmap_calls, memory_order_relaxed);
+    stats->munmap_calls = atomic_load_explicit(&munmap_calls, memory_order_relaxed);
+    stats->mremap_calls = atomic_load_explicit(&mremap_calls, memory_order_relaxed);
+    stats->mmap_bytes = atomic_load_explicit(&mmap_bytes, memory_order_relaxed);
+    stats->munmap_bytes = atomic_load_explicit(&munmap_bytes, memory_order_relaxed);
+}
+#else
+int syscall_stats_available(void) {
+    return 0;
+}
+
+void syscall_stats_get(syscall_stats_t* stats) {
+    memset(stats, 0, sizeof(syscall_stats_t));
+}
+#endif
+
+void syscall_stats_diff(syscall_stats_t* out, const syscall_stats_t* before,
+                        const syscall_stats_t* after) {
+    out->mmap_calls = after->mmap_calls - before->mmap_calls;
+    out->munmap_calls = after->munmap_calls - before->munmap_calls;
+    out->mremap_calls = after->mremap_calls - before->mremap_calls;
+    out->mmap_bytes = after->mmap_bytes - before->mmap_bytes;
+    out->munmap_bytes = after->munmap_bytes - before->munmap_bytes;
+}
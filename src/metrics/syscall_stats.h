@@ -0,0 +1,26 @@
+#ifndef SYSCALL_STATS_H
+#define SYSCALL_STATS_H
+
+#include <stddef.h>
+
+/* Counts of mmap/munmap/mremap calls made by code linked into allocbench.
+ * The build wraps these symbols at link time (-Wl,--wrap), so calls from the
+ * statically linked allocators are seen, but the C library's own malloc maps
+ * memory through internal entry points and is invisible here. */
+typedef struct {
+    size_t mmap_calls;
+    size_t munmap_calls;
+    size_t mremap_calls;
+    size_t mmap_bytes;
+    size_t munmap_bytes;
+} syscall_stats_t;
+
+/* Returns 0 when the build has no wrappers (Windows, macOS). */
+int syscall_stats_available(void);
+void syscall_stats_get(syscall_stats_t* stats);
+
+/* after - before, field by field. */
+void syscall_stats_diff(syscall_stats_t* out, const syscall_stats_t* before,
+                        const syscall_stats_t* after);
+
+#endif
@@ -0,0 +1,343 @@
+#include "system_info.h"
+#include "build_info.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <sys/utsname.h>
+#endif
+
+#ifdef __GLIBC__
+#include <gnu/libc-version.h>
+#endif
+
+/* Bounded copy that always terminates; returns the length written. */
+static size_t copy_string(char* dst, size_t dst_size, const char* src) {
+    size_t len = strlen(src);
+    if (len >= dst_size) len = dst_size - 1;
+    memcpy(dst, src, len);
+    dst[len] = '\0';
+    return len;
+}
+
+static void trim_trailing(char* str) {
+    size_t len = strlen(str);
+    while (len > 0 && (str[len - 1] == '\n' || str[len - 1] == '\r' ||
+                       str[len - 1] == ' ' || str[len - 1] == '\t')) {
+        str[--len] = '\0';
+    }
+}
+
+static void add_revision(system_info_t* info, const char* name, const char* revision) {
+    if (info->revision_count >= SYSTEM_INFO_MAX_REVISIONS) return;
+
+    allocator_revision_t* rev = &info->revisions[info->revision_count++];
+    copy_string(rev->name, sizeof(rev->name), name);
+    copy_string(rev->revision, sizeof(rev->revision),
+                (revision && revision[0]) ? revision : "unknown");
+}
+
+static void collect_build_info(system_info_t* info) {
+    copy_string(info->build_type, sizeof(info->build_type), ALLOCBENCH_BUILD_TYPE);
+    copy_string(info->compiler, sizeof(info->compiler), ALLOCBENCH_COMPILER);
+    copy_string(info->c_flags, sizeof(info->c_flags), ALLOCBENCH_C_FLAGS);
+
+#ifdef __GLIBC__
+    char glibc[64];
+    snprintf(glibc, sizeof(glibc), "glibc %s", gnu_get_libc_version());
+    add_revision(info, "system", glibc);
+#else
+    add_revision(info, "system", "unknown");
+#endif
+
+#ifdef HAVE_RPMALLOC
+    add_revision(info, "rpmalloc", ALLOCBENCH_REV_RPMALLOC);
+#endif
+#ifdef HAVE_MIMALLOC
+    add_revision(info, "mimalloc", ALLOCBENCH_REV_MIMALLOC);
+#endif
+#ifdef HAVE_JEMALLOC
+    add_revision(info, "jemalloc", ALLOCBENCH_REV_JEMALLOC);
+#endif
+#ifdef HAVE_TCMALLOC
+    add_revision(info, "tcmalloc", ALLOCBENCH_REV_TCMALLOC);
+#endif
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+
+int system_info_logical_cpus(void) {
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int)si.dwNumberOfProcessors;
+}
+
+void system_info_collect(system_info_t* info) {
+    memset(info, 0, sizeof(system_info_t));
+
+    char model[SYSTEM_INFO_STR] = "unknown";
+    DWORD model_size = sizeof(model);
+    RegGetValueA(HKEY_LOCAL_MACHINE, "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+                 "ProcessorNameString", RRF_RT_REG_SZ, NULL, model, &model_size);
+    trim_trailing(model);
+    copy_string(info->cpu_model, sizeof(info->cpu_model), model);
+
+    info->logical_cpus = system_info_logical_cpus();
+    info->physical_cores = info->logical_cpus;
+    copy_string(info->governor, sizeof(info->governor), "unknown");
+    copy_string(info->turbo, sizeof(info->turbo), "unknown");
+    copy_string(info->thp_enabled, sizeof(info->thp_enabled), "n/a");
+    copy_string(info->thp_defrag, sizeof(info->thp_defrag), "n/a");
+    copy_string(info->kernel, sizeof(info->kernel), "windows");
+    info->overcommit_memory = -1;
+    info->load_average = -1.0;
+
+    collect_build_info(info);
+}
+
+#else
+
+static int read_first_line(const char* path, char* buf, size_t buf_size) {
+    FILE* fp = fopen(path, "r");
+    if (!fp) return -1;
+
+    if (!fgets(buf, (int)buf_size, fp)) {
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+
+    trim_trailing(buf);
+    return 0;
+}
+
+/* sysfs THP knobs look like "always [madvise] never"; keep only the active one. */
+static void read_bracketed_choice(const char* path, char* out, size_t out_size) {
+    char line[256];
+    copy_string(out, out_size, "unknown");
+    if (read_first_line(path, line, sizeof(line)) != 0) return;
+
+    char* open = strchr(line, '[');
+    char* close = open ? strchr(open, ']') : NULL;
+    if (!open || !close) {
+        copy_string(out, out_size, line);
+        return;
+    }
+
+    *close = '\0';
+    copy_string(out, out_size, open + 1);
+}
+
+/* (physical id, core id) pairs already counted. Core ids are sparse and run
+ * well past the core count on large parts, so they are not used as indices. */
+typedef struct {
+    unsigned long long* keys;
+    size_t count;
+    size_t capacity;
+} core_set_t;
+
+static int core_set_add(core_set_t* set, unsigned long long key) {
+    for (size_t i = 0; i < set->count; i++) {
+        if (set->keys[i] == key) return 0;
+    }
+    if (set->count == set->capacity) {
+        size_t capacity = set->capacity ? set->capacity * 2 : 64;
+        unsigned long long* keys = realloc(set->keys, capacity * sizeof(*keys));
+        if (!keys) return 0;
+        set->keys = keys;
+        set->capacity = capacity;
+    }
+    set->keys[set->count++] = key;
+    return 1;
+}
+
+static void read_cpuinfo(system_info_t* info) {
+    copy_string(info->cpu_model, sizeof(info->cpu_model), "unknown");
+
+    FILE* fp = fopen("/proc/cpuinfo", "r");
+    if (!fp) return;
+
+    char line[512];
+    unsigned long physical_id = 0;
+    int have_model = 0;
+    core_set_t seen = {0};
+
+    while (fgets(line, sizeof(line), fp)) {
+        char* colon = strchr(line, ':');
+        if (!colon) continue;
+        char* value = colon + 1;
+        while (*value == ' ' || *value == '\t') value++;
+        trim_trailing(value);
+
+        if (!have_model && (strncmp(line, "model name", 10) == 0 ||
+                            strncmp(line, "Hardware", 8) == 0 ||
+                            strncmp(line, "cpu model", 9) == 0)) {
+            copy_string(info->cpu_model, sizeof(info->cpu_model), value);
+            have_model = 1;
+        } else if (strncmp(line, "physical id", 11) == 0) {
+            physical_id = strtoul(value, NULL, 10);
+        } else if (strncmp(line, "core id", 7) == 0) {
+            unsigned long core_id = strtoul(value, NULL, 10);
+            unsigned long long key = ((unsigned long long)physical_id << 32) | (core_id & 0xFFFFFFFFul);
+            if (core_set_add(&seen, key)) info->physical_cores++;
+        }
+    }
+
+    free(seen.keys);
+    fclose(fp);
+}
+
+int system_info_logical_cpus(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+void system_info_collect(system_info_t* info) {
+    memset(info, 0, sizeof(system_info_t));
+    char buf[256];
+
+    read_cpuinfo(info);
+    info->logical_cpus = system_info_logical_cpus();
+    if (info->physical_cores == 0) info->physical_cores = info->logical_cpus;
+
+    if (read_first_line("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor",
+                        buf, sizeof(buf)) == 0) {
+        copy_string(info->governor, sizeof(info->governor), buf);
+    } else {
+        copy_string(info->governor, sizeof(info->governor), "unknown");
+    }
+
+    copy_string(info->turbo, sizeof(info->turbo), "unknown");
+    if (read_first_line("/sys/devices/system/cpu/intel_pstate/no_turbo", buf, sizeof(buf)) == 0) {
+        copy_string(info->turbo, sizeof(info->turbo), atoi(buf) ? "disabled" : "enabled");
+    } else if (read_first_line("/sys/devices/system/cpu/cpufreq/boost", buf, sizeof(buf)) == 0) {
+        copy_string(info->turbo, sizeof(info->turbo), atoi(buf) ? "enabled" : "disabled");
+    }
+
+    read_bracketed_choice("/sys/kernel/mm/transparent_hugepage/enabled",
+                          info->thp_enabled, sizeof(info->thp_enabled));
+    read_bracketed_choice("/sys/kernel/mm/transparent_hugepage/defrag",
+                          info->thp_defrag, sizeof(info->thp_defrag));
+
+    struct utsname uts;
+    if (uname(&uts) == 0) {
+        const char* parts[] = {uts.release, uts.machine};
+        size_t len = copy_string(info->kernel, sizeof(info->kernel), uts.sysname);
+        for (int i = 0; i < 2 && len + 1 < sizeof(info->kernel); i++) {
+            info->kernel[len++] = ' ';
+            len += copy_string(info->kernel + len, sizeof(info->kernel) - len, parts[i]);
+        }
+    } else {
+        copy_string(info->kernel, sizeof(info->kernel), "unknown");
+    }
+
+    info->overcommit_memory = -1;
+    if (read_first_line("/proc/sys/vm/overcommit_memory", buf, sizeof(buf)) == 0) {
+        info->overcommit_memory = atoi(buf);
+    }
+
+    info->load_average = -1.0;
+    if (read_first_line("/proc/loadavg", buf, sizeof(buf)) == 0) {
+        info->load_average = atof(buf);
+    }
+
+    collect_build_info(info);
+}
+
+#endif
+
+int system_info_print_warnings(const system_info_t* info) {
+    int warnings = 0;
+
+    if (strcmp(info->governor, "powersave") == 0 ||
+        strcmp(info->governor, "ondemand") == 0 ||
+        strcmp(info->governor, "conservative") == 0 ||
+        strcmp(info->governor, "schedutil") == 0) {
+        printf("WARNING: CPU frequency governor is '%s', results will be noisy "
+               "(use 'performance')\n", info->governor);
+        warnings++;
+    }
+
+    if (strcmp(info->turbo, "enabled") == 0) {
+        printf("WARNING: turbo/boost is enabled, clock speed will vary with temperature and load\n");
+        warnings++;
+    }
+
+    double load_limit = info->logical_cpus * 0.25;
+    if (load_limit < 1.0) load_limit = 1.0;
+    if (info->load_average > load_limit) {
+        printf("WARNING: load average is %.2f on %d CPUs, other processes are competing "
+               "for the machine\n", info->load_average, info->logical_cpus);
+        warnings++;
+    }
+
+    if (strcmp(info->build_type, "Release") != 0 && strcmp(info->build_type, "RelWithDebInfo") != 0) {
+        printf("WARNING: allocbench was built as '%s', not Release\n", info->build_type);
+        warnings++;
+    }
+
+    return warnings;
+}
+
+static void write_json_string(FILE* fp, const char* str) {
+    fputc('"', fp);
+    while (*str) {
+        switch (*str) {
+            case '"': fputs("\\\"", fp); break;
+            case '\\': fputs("\\\\", fp); break;
+            case '\n': fputs("\\n", fp); break;
+            case '\r': fputs("\\r", fp); break;
+            case '\t': fputs("\\t", fp); break;
+            default: fputc(*str, fp);
+        }
+        str++;
+    }
+    fputc('"', fp);
+}
+
+static void write_field(FILE* fp, const char* indent, const char* key, const char* value) {
+    fprintf(fp, "%s  \"%s\": ", indent, key);
+    write_json_string(fp, value);
+    fprintf(fp, ",\n");
+}
+
+void system_info_write_json(FILE* fp, const system_info_t* info, const char* indent) {
+    fprintf(fp, "{\n");
+    write_field(fp, indent, "cpu_model", info->cpu_model);
+    fprintf(fp, "%s  \"logical_cpus\": %d,\n", indent, info->logical_cpus);
+    fprintf(fp, "%s  \"physical_cores\": %d,\n", indent, info->physical_cores);
+    write_field(fp, indent, "governor", info->governor);
+    write_field(fp, indent, "turbo", info->turbo);
+    write_field(fp, indent, "thp_enabled", info->thp_enabled);
+    write_field(fp, indent, "thp_defrag", info->thp_defrag);
+    write_field(fp, indent, "kernel", info->kernel);
+
+    if (info->overcommit_memory < 0)
+        fprintf(fp, "%s  \"overcommit_memory\": null,\n", indent);
+    else
+        fprintf(fp, "%s  \"overcommit_memory\": %d,\n", indent, info->overcommit_memory);
+
+    if (info->load_average < 0)
+        fprintf(fp, "%s  \"load_average\": null,\n", indent);
+    else
+        fprintf(fp, "%s  \"load_average\": %.2f,\n", indent, info->load_average);
+
+    write_field(fp, indent, "build_type", info->build_type);
+    write_field(fp, indent, "compiler", info->compiler);
+    write_field(fp, indent, "c_flags", info->c_flags);
+
+    fprintf(fp, "%s  \"allocator_revisions\": {\n", indent);
+    for (int i = 0; i < info->revision_count; i++) {
+        fprintf(fp, "%s    ", indent);
+        write_json_string(fp, info->revisions[i].name);
+        fprintf(fp, ": ");
+        write_json_string(fp, info->revisions[i].revision);
+        fprintf(fp, "%s\n", (i < info->revision_count - 1) ? "," : "");
+    }
+    fprintf(fp, "%s  }\n", indent);
+    fprintf(fp, "%s}", indent);
+}
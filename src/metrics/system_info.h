@@ -0,0 +1,39 @@
+#ifndef SYSTEM_INFO_H
+#define SYSTEM_INFO_H
+
+#include <stdio.h>
+
+#define SYSTEM_INFO_STR 128
+#define SYSTEM_INFO_MAX_REVISIONS 8
+
+typedef struct {
+    char name[32];
+    char revision[64];
+} allocator_revision_t;
+
+typedef struct {
+    char cpu_model[SYSTEM_INFO_STR];
+    int logical_cpus;
+    int physical_cores;
+    char governor[32];
+    char turbo[16];
+    char thp_enabled[32];
+    char thp_defrag[32];
+    char kernel[SYSTEM_INFO_STR];
+    int overcommit_memory;
+    double load_average;
+
+    char build_type[32];
+    char compiler[64];
+    char c_flags[256];
+    allocator_revision_t revisions[SYSTEM_INFO_MAX_REVISIONS];
+    int revision_count;
+} system_info_t;
+
+void system_info_collect(system_info_t* info);
+int system_info_logical_cpus(void);
+
+int system_info_print_warnings(const system_info_t* info);
+void system_info_write_json(FILE* fp, const system_info_t* info, const char* indent);
+
+#endif
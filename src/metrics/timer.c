@@ -37,6 +37,37 @@ double timer_get_elapsed_ms(void) { return timer_end_ms(); }
 double timer_get_elapsed_us(void) { return timer_end_us(); }
 double timer_get_elapsed_ns(void) { return timer_end_ns(); }
 
+double timer_now_ns(void) {
+    if (!timer_initialized) {
+        QueryPerformanceFrequency(&timer_freq);
+        timer_initialized = 1;
+    }
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * 1000000000.0 / timer_freq.QuadPart;
+}
+
+static double filetime_sum_ns(const FILETIME* kernel, const FILETIME* user) {
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernel->dwLowDateTime;
+    k.HighPart = kernel->dwHighDateTime;
+    u.LowPart = user->dwLowDateTime;
+    u.HighPart = user->dwHighDateTime;
+    return (double)(k.QuadPart + u.QuadPart) * 100.0;
+}
+
+double timer_process_cpu_ns(void) {
+    FILETIME creation, exit_time, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit_time, &kernel, &user)) return 0.0;
+    return filetime_sum_ns(&kernel, &user);
+}
+
+double timer_thread_cpu_ns(void) {
+    FILETIME creation, exit_time, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit_time, &kernel, &user)) return 0.0;
+    return filetime_sum_ns(&kernel, &user);
+}
+
 uint64_t get_cycles(void) {
     return __rdtsc();
 }
@@ -86,6 +117,24 @@ double timer_get_elapsed_ms(void) { return timer_end_ms(); }
 double timer_get_elapsed_us(void) { return timer_end_us(); }
 double timer_get_elapsed_ns(void) { return timer_end_ns(); }
 
+double timer_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000.0 + now.tv_nsec;
+}
+
+double timer_process_cpu_ns(void) {
+    struct timespec now;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now) != 0) return 0.0;
+    return now.tv_sec * 1000000000.0 + now.tv_nsec;
+}
+
+double timer_thread_cpu_ns(void) {
+    struct timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0) return 0.0;
+    return now.tv_sec * 1000000000.0 + now.tv_nsec;
+}
+
 uint64_t get_cycles(void) {
     uint32_t lo, hi;
     __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
@@ -10,6 +10,11 @@ double timer_end_ns(void);
 double timer_get_elapsed_ms(void);
 double timer_get_elapsed_us(void);
 double timer_get_elapsed_ns(void);
+double timer_now_ns(void);
+
+/* CPU time (user + system) used by the whole process and by the calling thread. */
+double timer_process_cpu_ns(void);
+double timer_thread_cpu_ns(void);
 
 typedef struct {
     uint64_t start_cycles;
@@ -0,0 +1,115 @@
+#include "timeseries.h"
+#include "timer.h"
+#include <string.h>
+
+/* Halves the resolution in place so long runs stay within MAX_SERIES_SAMPLES. */
+static void series_compact(benchmark_series_t* series) {
+    int half = series->count / 2;
+    for (int i = 0; i < half; i++) {
+        series->values[i] = (series->values[2 * i] + series->values[2 * i + 1]) * 0.5f;
+    }
+    if (series->count % 2) {
+        series->values[half] = series->values[series->count - 1];
+        half++;
+    }
+    series->count = half;
+    series->interval_ms *= 2.0;
+}
+
+static void series_push(series_sampler_t* sampler, float rate) {
+    benchmark_series_t* series = sampler->series;
+    series->values[series->count++] = rate;
+
+    if (series->count == MAX_SERIES_SAMPLES) {
+        series_compact(series);
+        sampler->interval_ns *= 2.0;
+    }
+}
+
+void series_sampler_init_at(series_sampler_t* sampler, benchmark_series_t* series,
+                            double interval_ms, double start_ns) {
+    memset(sampler, 0, sizeof(series_sampler_t));
+    sampler->series = series;
+    if (series) memset(series, 0, sizeof(benchmark_series_t));
+
+    sampler->enabled = series && interval_ms > 0;
+    if (!sampler->enabled) return;
+
+    series->interval_ms = interval_ms;
+    sampler->interval_ns = interval_ms * 1e6;
+    sampler->start_ns = start_ns;
+    sampler->slice_start_ns = start_ns;
+}
+
+void series_sampler_init(series_sampler_t* sampler, benchmark_series_t* series,
+                         double interval_ms) {
+    series_sampler_init_at(sampler, series, interval_ms, timer_now_ns());
+}
+
+void series_sampler_poll(series_sampler_t* sampler) {
+    if (!sampler->enabled) return;
+
+    double now = timer_now_ns();
+    while (now - sampler->slice_start_ns >= sampler->interval_ns) {
+        double width_ns = sampler->interval_ns;
+        series_push(sampler, (float)(sampler->pending_ops / (width_ns / 1e9)));
+        sampler->pending_ops = 0;
+        sampler->slice_start_ns += width_ns;
+    }
+}
+
+void series_sampler_finish(series_sampler_t* sampler) {
+    if (!sampler->enabled) return;
+
+    series_sampler_poll(sampler);
+
+    /* Keep the trailing partial slice only if it is long enough to be meaningful. */
+    double partial_ns = timer_now_ns() - sampler->slice_start_ns;
+    if (partial_ns > sampler->interval_ns * 0.25 && sampler->pending_ops > 0) {
+        series_push(sampler, (float)(sampler->pending_ops / (partial_ns / 1e9)));
+    }
+    sampler->pending_ops = 0;
+    sampler->enabled = 0;
+}
+
+void series_push_value(benchmark_series_t* series, float value) {
+    series->values[series->count++] = value;
+    if (series->count == MAX_SERIES_SAMPLES) series_compact(series);
+}
+
+void gauge_series_init(benchmark_gauge_series_t* series, double interval_ops) {
+    memset(series, 0, sizeof(benchmark_gauge_series_t));
+    series->interval_ops = interval_ops;
+}
+
+void gauge_series_push(benchmark_gauge_series_t* series, float value) {
+    series->values[series->count++] = value;
+    if (series->count < MAX_SERIES_SAMPLES) return;
+
+    int half = series->count / 2;
+    for (int i = 0; i < half; i++) {
+        series->values[i] = (series->values[2 * i] + series->values[2 * i + 1]) * 0.5f;
+    }
+    series->count = half;
+    series->interval_ops *= 2.0;
+}
+
+void series_merge(benchmark_series_t* dst, const benchmark_series_t* src) {
+    if (src->count == 0) return;
+    if (dst->count == 0) {
+        *dst = *src;
+        return;
+    }
+
+    benchmark_series_t other = *src;
+    while (dst->interval_ms < other.interval_ms) series_compact(dst);
+    while (other.interval_ms < dst->interval_ms) series_compact(&other);
+
+    int count = dst->count > other.count ? dst->count : other.count;
+    for (int i = 0; i < count; i++) {
+        float a = i < dst->count ? dst->values[i] : 0.0f;
+        float b = i < other.count ? other.values[i] : 0.0f;
+        dst->values[i] = a + b;
+    }
+    dst->count = count;
+}
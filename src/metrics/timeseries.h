@@ -0,0 +1,46 @@
+#ifndef TIMESERIES_H
+#define TIMESERIES_H
+
+#include <stddef.h>
+#include "../benchmark.h"
+
+/* Clock reads are amortized: the sampler only looks at the time every
+ * SERIES_POLL_MASK + 1 calls to series_sampler_add. */
+#define SERIES_POLL_MASK 63
+
+typedef struct {
+    benchmark_series_t* series;
+    double start_ns;
+    double slice_start_ns;
+    double interval_ns;
+    double pending_ops;
+    unsigned int ticks;
+    int enabled;
+} series_sampler_t;
+
+void series_sampler_init(series_sampler_t* sampler, benchmark_series_t* series,
+                         double interval_ms);
+void series_sampler_init_at(series_sampler_t* sampler, benchmark_series_t* series,
+                            double interval_ms, double start_ns);
+void series_sampler_poll(series_sampler_t* sampler);
+void series_sampler_finish(series_sampler_t* sampler);
+
+static inline void series_sampler_add(series_sampler_t* sampler, size_t ops) {
+    if (!sampler->enabled) return;
+    sampler->pending_ops += (double)ops;
+    if ((++sampler->ticks & SERIES_POLL_MASK) == 0) series_sampler_poll(sampler);
+}
+
+/* Appends a sampled value (rather than a rate) to a time series; like the
+ * sampler, a full series halves its resolution and doubles interval_ms. */
+void series_push_value(benchmark_series_t* series, float value);
+
+void gauge_series_init(benchmark_gauge_series_t* series, double interval_ops);
+
+/* Appends one reading; a full series averages adjacent pairs and doubles
+ * interval_ops, so callers should re-read the interval after each push. */
+void gauge_series_push(benchmark_gauge_series_t* series, float value);
+
+void series_merge(benchmark_series_t* dst, const benchmark_series_t* src);
+
+#endif
@@ -0,0 +1,258 @@
+#include "size_dist.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Octaves are split into this many geometric sub-buckets for the continuous
+ * shapes, which keeps the uniform-within-bucket error small. */
+#define SUB_BUCKETS_PER_OCTAVE 4
+
+static const char* parse_size(const char* str, size_t* out) {
+    char* end = NULL;
+    double value = strtod(str, &end);
+    if (end == str || value < 0) return NULL;
+
+    switch (*end) {
+        case 'k': case 'K': value *= 1024.0; end++; break;
+        case 'm': case 'M': value *= 1024.0 * 1024.0; end++; break;
+        case 'g': case 'G': value *= 1024.0 * 1024.0 * 1024.0; end++; break;
+        default: break;
+    }
+    *out = (size_t)value;
+    return end;
+}
+
+static const char* parse_range(const char* str, size_t* lo, size_t* hi) {
+    str = parse_size(str, lo);
+    if (!str) return NULL;
+
+    if (*str == '-') {
+        str = parse_size(str + 1, hi);
+        if (!str) return NULL;
+    } else {
+        *hi = *lo;
+    }
+
+    if (*lo < 1 || *hi < *lo) return NULL;
+    return str;
+}
+
+static void reset(size_dist_t* dist) {
+    dist->bucket_count = 0;
+    dist->min_size = 0;
+    dist->max_size = 0;
+    dist->mean_size = 0;
+}
+
+static int add_bucket(size_dist_t* dist, size_t lo, size_t hi, double weight) {
+    if (weight <= 0) return 0;
+    if (dist->bucket_count >= SIZE_DIST_MAX_BUCKETS) return -1;
+
+    int i = dist->bucket_count++;
+    dist->lo[i] = lo;
+    dist->hi[i] = hi;
+    dist->prob[i] = weight;
+    return 0;
+}
+
+/* Weight of [a, b] under density x^-alpha; alpha == 1 is log-uniform. */
+static double power_mass(double a, double b, double alpha) {
+    if (fabs(alpha - 1.0) < 1e-9) return log(b / a);
+    return (pow(b, 1.0 - alpha) - pow(a, 1.0 - alpha)) / (1.0 - alpha);
+}
+
+static int add_power_buckets(size_dist_t* dist, size_t lo, size_t hi, double alpha) {
+    double step = pow(2.0, 1.0 / SUB_BUCKETS_PER_OCTAVE);
+    size_t start = lo;
+
+    while (start <= hi) {
+        size_t end = (size_t)ceil((double)start * step) - 1;
+        if (end < start) end = start;
+        if (end > hi) end = hi;
+
+        double mass = power_mass((double)start, (double)end + 1.0, alpha);
+        if (add_bucket(dist, start, end, mass) != 0) return -1;
+
+        if (end == hi) break;
+        start = end + 1;
+    }
+    return 0;
+}
+
+/* Vose's alias method: after normalizing, every column holds probability
+ * prob[i] of itself and 1 - prob[i] of alias[i]. */
+static int build_alias(size_dist_t* dist) {
+    int n = dist->bucket_count;
+    if (n == 0) return -1;
+
+    double total = 0;
+    double mean = 0;
+    dist->min_size = dist->lo[0];
+    dist->max_size = dist->hi[0];
+    for (int i = 0; i < n; i++) {
+        total += dist->prob[i];
+        mean += dist->prob[i] * ((double)dist->lo[i] + (double)dist->hi[i]) * 0.5;
+        if (dist->lo[i] < dist->min_size) dist->min_size = dist->lo[i];
+        if (dist->hi[i] > dist->max_size) dist->max_size = dist->hi[i];
+    }
+    if (total <= 0) return -1;
+    dist->mean_size = mean / total;
+
+    int small[SIZE_DIST_MAX_BUCKETS];
+    int large[SIZE_DIST_MAX_BUCKETS];
+    int small_count = 0, large_count = 0;
+
+    for (int i = 0; i < n; i++) {
+        dist->prob[i] = dist->prob[i] * n / total;
+        dist->alias[i] = (unsigned int)i;
+        if (dist->prob[i] < 1.0)
+            small[small_count++] = i;
+        else
+            large[large_count++] = i;
+    }
+
+    while (small_count > 0 && large_count > 0) {
+        int s = small[--small_count];
+        int l = large[--large_count];
+
+        dist->alias[s] = (unsigned int)l;
+        dist->prob[l] -= 1.0 - dist->prob[s];
+
+        if (dist->prob[l] < 1.0)
+            small[small_count++] = l;
+        else
+            large[large_count++] = l;
+    }
+
+    /* Leftovers are 1.0 up to rounding error. */
+    while (large_count > 0) dist->prob[large[--large_count]] = 1.0;
+    while (small_count > 0) dist->prob[small[--small_count]] = 1.0;
+
+    return 0;
+}
+
+void size_dist_uniform(size_dist_t* dist, size_t min_size, size_t max_size) {
+    reset(dist);
+    if (max_size < min_size) max_size = min_size;
+    add_bucket(dist, min_size, max_size, 1.0);
+    build_alias(dist);
+}
+
+static int parse_discrete(size_dist_t* dist, const char* str) {
+    while (*str) {
+        size_t size;
+        str = parse_size(str, &size);
+        if (!str || *str != '=' || size < 1) return -1;
+
+        char* end = NULL;
+        double weight = strtod(str + 1, &end);
+        if (end == str + 1) return -1;
+        if (add_bucket(dist, size, size, weight) != 0) return -1;
+
+        str = end;
+        if (*str == ',') str++;
+        else if (*str) return -1;
+    }
+    return 0;
+}
+
+static int parse_file(size_dist_t* dist, const char* path) {
+    FILE* fp = fopen(path, "r");
+    if (!fp) return -1;
+
+    char line[256];
+    int ret = 0;
+    while (ret == 0 && fgets(line, sizeof(line), fp)) {
+        const char* p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        size_t lo, hi;
+        p = parse_range(p, &lo, &hi);
+        if (!p) {
+            ret = -1;
+            break;
+        }
+
+        char* end = NULL;
+        double weight = strtod(p, &end);
+        if (end == p) weight = 1.0;
+        ret = add_bucket(dist, lo, hi, weight);
+    }
+
+    fclose(fp);
+    return ret;
+}
+
+static int parse_spec(size_dist_t* dist, const char* spec) {
+    const char* colon = strchr(spec, ':');
+    if (!colon) return -1;
+
+    size_t kind_len = (size_t)(colon - spec);
+    const char* args = colon + 1;
+    size_t lo, hi, lo2, hi2;
+
+    if (strncmp(spec, "uniform", kind_len) == 0 && kind_len == 7) {
+        if (!(args = parse_range(args, &lo, &hi)) || *args) return -1;
+        return add_bucket(dist, lo, hi, 1.0);
+    }
+
+    if (strncmp(spec, "loguniform", kind_len) == 0 && kind_len == 10) {
+        if (!(args = parse_range(args, &lo, &hi)) || *args) return -1;
+        return add_power_buckets(dist, lo, hi, 1.0);
+    }
+
+    if ((kind_len == 4 && strncmp(spec, "zipf", 4) == 0) ||
+        (kind_len == 8 && strncmp(spec, "powerlaw", 8) == 0)) {
+        double alpha = 1.0;
+        if (!(args = parse_range(args, &lo, &hi))) return -1;
+        if (*args == ':') {
+            char* end = NULL;
+            alpha = strtod(args + 1, &end);
+            if (end == args + 1 || *end) return -1;
+        } else if (*args) {
+            return -1;
+        }
+        return add_power_buckets(dist, lo, hi, alpha);
+    }
+
+    if (kind_len == 7 && strncmp(spec, "bimodal", 7) == 0) {
+        double p = 0.9;
+        if (!(args = parse_range(args, &lo, &hi)) || *args != ':') return -1;
+        if (!(args = parse_range(args + 1, &lo2, &hi2))) return -1;
+        if (*args == ':') {
+            char* end = NULL;
+            p = strtod(args + 1, &end);
+            if (end == args + 1 || *end || p < 0 || p > 1) return -1;
+        } else if (*args) {
+            return -1;
+        }
+        if (add_bucket(dist, lo, hi, p) != 0) return -1;
+        return add_bucket(dist, lo2, hi2, 1.0 - p);
+    }
+
+    if (kind_len == 8 && strncmp(spec, "discrete", 8) == 0) {
+        return parse_discrete(dist, args);
+    }
+
+    if (kind_len == 4 && strncmp(spec, "file", 4) == 0) {
+        return parse_file(dist, args);
+    }
+
+    return -1;
+}
+
+int size_dist_init(size_dist_t* dist, const char* spec, size_t min_size, size_t max_size) {
+    if (!spec || !spec[0]) {
+        size_dist_uniform(dist, min_size, max_size);
+        return 0;
+    }
+
+    reset(dist);
+    if (parse_spec(dist, spec) != 0 || build_alias(dist) != 0) {
+        size_dist_uniform(dist, min_size, max_size);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef SIZE_DIST_H
+#define SIZE_DIST_H
+
+#include <stddef.h>
+
+#define SIZE_DIST_MAX_BUCKETS 256
+#define SIZE_DIST_MAX_SPEC 256
+
+/* Allocation size distribution. Every distribution is reduced to weighted
+ * [lo, hi] buckets; a draw picks a bucket with Vose's alias method (O(1))
+ * and then a size uniformly inside it.
+ *
+ * Spec strings (sizes accept K/M/G suffixes):
+ *   uniform:LO-HI
+ *   loguniform:LO-HI
+ *   zipf:LO-HI:ALPHA            density proportional to size^-ALPHA
+ *   bimodal:LO-HI:LO-HI:P       first range drawn with probability P
+ *   discrete:SIZE=W,SIZE=W,...  exact sizes with relative weights
+ *   file:PATH                   one "SIZE WEIGHT" or "LO-HI WEIGHT" per line
+ */
+typedef struct {
+    size_t lo[SIZE_DIST_MAX_BUCKETS];
+    size_t hi[SIZE_DIST_MAX_BUCKETS];
+    double prob[SIZE_DIST_MAX_BUCKETS];
+    unsigned int alias[SIZE_DIST_MAX_BUCKETS];
+    int bucket_count;
+    size_t min_size;
+    size_t max_size;
+    double mean_size;
+} size_dist_t;
+
+void size_dist_uniform(size_dist_t* dist, size_t min_size, size_t max_size);
+
+/* A NULL or empty spec gives uniform:min_size-max_size. Returns -1 and
+ * leaves the uniform fallback in place if the spec cannot be parsed. */
+int size_dist_init(size_dist_t* dist, const char* spec, size_t min_size, size_t max_size);
+
+/* Same xorshift32 step the benchmarks use, so a single uniform bucket draws
+ * exactly the sizes the old min + rand % range code did. */
+static inline unsigned int size_dist_next(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static inline size_t size_dist_sample(const size_dist_t* dist, unsigned int* state) {
+    int bucket = 0;
+    if (dist->bucket_count > 1) {
+        unsigned int column = size_dist_next(state) % (unsigned int)dist->bucket_count;
+        double coin = (double)(size_dist_next(state) >> 8) * (1.0 / 16777216.0);
+        bucket = coin < dist->prob[column] ? (int)column : (int)dist->alias[column];
+    }
+
+    size_t lo = dist->lo[bucket];
+    size_t hi = dist->hi[bucket];
+    return lo + (size_dist_next(state) % (hi - lo + 1));
+}
+
+#endif
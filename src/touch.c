@@ -0,0 +1,82 @@
+#include "touch.h"
+#include <string.h>
+
+#define TOUCH_LINE_SIZE 64
+#define TOUCH_FILL_BYTE 0xa5
+
+static allocator_api_t touch_real;
+static touch_mode_t touch_mode = TOUCH_NONE;
+
+int touch_mode_parse(const char* str, touch_mode_t* mode) {
+    if (strcmp(str, "none") == 0) *mode = TOUCH_NONE;
+    else if (strcmp(str, "first-line") == 0) *mode = TOUCH_FIRST_LINE;
+    else if (strcmp(str, "full") == 0) *mode = TOUCH_FULL;
+    else return -1;
+    return 0;
+}
+
+const char* touch_mode_name(touch_mode_t mode) {
+    switch (mode) {
+        case TOUCH_FIRST_LINE: return "first-line";
+        case TOUCH_FULL: return "full";
+        default: return "none";
+    }
+}
+
+/* The constant-size memset is expanded inline into vector stores, and the
+ * library memset is already vectorized for the full fill. */
+static void touch_fill(void* ptr, size_t size, int value) {
+    if (!ptr) return;
+    if (touch_mode == TOUCH_FULL) {
+        memset(ptr, value, size);
+    } else if (size >= TOUCH_LINE_SIZE) {
+        memset(ptr, value, TOUCH_LINE_SIZE);
+    } else {
+        memset(ptr, value, size);
+    }
+}
+
+/* realloc must keep the old contents, so rewrite what is already there: one
+ * byte per cache line is enough to fault in and dirty every page. */
+static void touch_preserve(void* ptr, size_t size) {
+    if (!ptr || size == 0) return;
+    volatile unsigned char* bytes = ptr;
+    size_t end = touch_mode == TOUCH_FULL ? size : 1;
+    for (size_t off = 0; off < end; off += TOUCH_LINE_SIZE) bytes[off] = bytes[off];
+}
+
+static void* touch_malloc(size_t size) {
+    void* ptr = touch_real.malloc(size);
+    touch_fill(ptr, size, TOUCH_FILL_BYTE);
+    return ptr;
+}
+
+static void* touch_calloc(size_t num, size_t size) {
+    void* ptr = touch_real.calloc(num, size);
+    touch_fill(ptr, num * size, 0);
+    return ptr;
+}
+
+static void* touch_realloc(void* ptr, size_t size) {
+    void* new_ptr = touch_real.realloc(ptr, size);
+    touch_preserve(new_ptr, size);
+    return new_ptr;
+}
+
+static void* touch_aligned_alloc(size_t alignment, size_t size) {
+    void* ptr = touch_real.aligned_alloc(alignment, size);
+    touch_fill(ptr, size, TOUCH_FILL_BYTE);
+    return ptr;
+}
+
+void touch_api_wrap(allocator_api_t* wrapped, const allocator_api_t* real, touch_mode_t mode) {
+    *wrapped = *real;
+    if (mode == TOUCH_NONE) return;
+
+    touch_real = *real;
+    touch_mode = mode;
+    if (real->malloc) wrapped->malloc = touch_malloc;
+    if (real->calloc) wrapped->calloc = touch_calloc;
+    if (real->realloc) wrapped->realloc = touch_realloc;
+    if (real->aligned_alloc) wrapped->aligned_alloc = touch_aligned_alloc;
+}
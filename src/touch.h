@@ -0,0 +1,24 @@
+#ifndef TOUCH_H
+#define TOUCH_H
+
+#include <stddef.h>
+#include "allocator_api.h"
+
+/* How much of every block the harness writes before handing it to the
+ * benchmark. The write happens inside the allocator call the benchmark is
+ * timing, so lazily committed pages are paid for where they are obtained. */
+typedef enum {
+    TOUCH_NONE,
+    TOUCH_FIRST_LINE,
+    TOUCH_FULL
+} touch_mode_t;
+
+int touch_mode_parse(const char* str, touch_mode_t* mode);
+const char* touch_mode_name(touch_mode_t mode);
+
+/* Fills *wrapped with an API that forwards to real and then touches the
+ * result. Only one wrapped API is active at a time; with TOUCH_NONE this is
+ * a plain copy of real. */
+void touch_api_wrap(allocator_api_t* wrapped, const allocator_api_t* real, touch_mode_t mode);
+
+#endif